@@ -23,23 +23,124 @@
 // 最大任务优先级数
 // 任务的优先级范围是从 0 (最低) 到 (MYRTOS_MAX_PRIORITIES - 1) (最高)
 // 例如，设置为 32，则优先级范围为 0-31
-// 注意：必须 <= 32（受限于优先级位图实现）
+// 注意：必须 <= 256。不超过 32 时使用单字位图, 超过时自动切换为两级位图
 #define MYRTOS_MAX_PRIORITIES (32)
 
 // 系统支持的最大并发任务数
-// 这个值决定了任务ID池的大小
+// 这个值决定了任务ID池的大小, 内核及 IO/Monitor 服务按它静态分配以任务ID为下标的槽位表
 // 例如，设置为 64，系统最多可以同时并发64个任务
-// 注意：必须 <= 64（受限于当前taskIdBitmap实现）
+// 注意：必须 <= 65535（任务引用 TaskRef_t 中任务ID占16位）
 #define MYRTOS_MAX_CONCURRENT_TASKS (64)
 
 // 定义用于无限期阻塞等待的Tick计数值
 // 通常是一个无符号整数的最大值
 #define MYRTOS_MAX_DELAY (0xFFFFFFFFUL)
 
+// 新建任务默认的时间片长度 (单位: Tick)
+// 同优先级的任务只在时间片耗尽时轮转, 可通过 Task_SetTimeSlice() 为单个任务单独设置
+// 0 表示不参与轮转, 任务一直运行到阻塞或调用 Task_Yield()
+#define MYRTOS_DEFAULT_TIME_SLICE (10)
+
+// 延迟任务时间轮每级的槽位数位宽 (槽位数 = 2^bits)
+// 两级时间轮可直接覆盖 2^(2*bits) 个Tick 内的超时, 更远的超时进入溢出链表并周期性回填
+// 每增加1, 时间轮占用的RAM翻倍 (每个槽位8字节, 共两级)
+#define MYRTOS_DELAY_WHEEL_BITS (6)
+
+// 低功耗空闲模式 (Tickless Idle)
+// 1 = 所有任务阻塞时, 空闲任务把 SysTick 重新编程到最近的任务唤醒时间后执行 WFI,
+//     醒来后补偿系统滴答计数; 0 = 每个Tick都产生中断
+// 自定义空闲任务需要在循环中调用 MyRTOS_Idle_Sleep() 代替 WFI
+#define MYRTOS_USE_TICKLESS_IDLE 0
+
+// 进入低功耗空闲模式所需的最少空闲Tick数, 更短的空闲只执行普通的 WFI
+#define MYRTOS_TICKLESS_MIN_IDLE_TICKS (2)
+
+// 最早截止时间优先 (EDF) 调度类
+// 1 = 启用: 通过 Task_CreateEDF 创建的周期任务运行在 MYRTOS_EDF_PRIORITY 上,
+//     该优先级内按当前作业的绝对截止时间排序, 截止时间越早越先运行;
+//     高于和低于该优先级的任务仍按固定优先级抢占, 不受影响
+// 0 = 禁用: 只有固定优先级调度
+#define MYRTOS_USE_EDF 0
+
+// EDF 调度类占用的优先级
+// 该优先级上的任务不参与时间片轮转, 不要再用它创建普通的固定优先级任务
+#define MYRTOS_EDF_PRIORITY (MYRTOS_MAX_PRIORITIES / 2)
+
+// 中断延迟调用 (下半部)
+// 1 = 启用: 中断通过 MyRTOS_DeferFromISR 把函数和参数投递到无锁队列,
+//     由最高优先级的守护任务按 FIFO 顺序执行, 并按来源统计等待延迟和执行耗时
+// 0 = 禁用
+#define MYRTOS_USE_DEFERRED_CALL 0
+
+// 延迟调用队列长度, 必须是2的幂; 队列满时新的投递被丢弃并计入统计
+#define MYRTOS_DEFERRED_QUEUE_LENGTH (32)
+
+// 延迟调用统计的来源数, 投递时的来源编号必须小于该值
+#define MYRTOS_DEFERRED_MAX_SOURCES (8)
+
+// EventGroup_SetBitsFromISR 投递延迟调用时使用的来源编号, 不要与其他中断的来源编号重复,
+// 以便在延迟调用统计中单独查看事件组的中断置位
+#define MYRTOS_EVENT_GROUP_DEFER_SOURCE (MYRTOS_DEFERRED_MAX_SOURCES - 1)
+
+// CPU预算服务器 (可延迟服务器)
+// 1 = 启用: Task_SetBudget 为任务设置 "每个周期最多运行N个Tick" 的预算, 由系统滴答中断逐Tick收取,
+//     预算用完的任务被挂起到当前周期结束, 预算在周期边界一次性补满; 适合限制后台任务/进程的CPU占用
+// 0 = 禁用: 任务控制块中不包含预算字段
+#define MYRTOS_USE_BUDGET 0
+
+// 同步原语快速路径
+// 1 = 启用: 无竞争的 Mutex_Lock/Mutex_Unlock/Semaphore_Take/Semaphore_Give 用 LDREX/STREX 独占访问指令
+//     直接修改锁字, 不屏蔽中断; 只有存在等待者 (或需要恢复继承的优先级) 时才进入临界区路径。
+//     仅对 ARMv7-M (Cortex-M3/M4) 移植层生效, 其他移植层自动使用临界区路径
+// 0 = 禁用: 所有操作都进入临界区, 与旧版本行为一致
+#define MYRTOS_USE_SYNC_FAST_PATH 1
+
+// 优先级继承沿互斥锁链传递的最大深度
+// 高优先级任务等待的锁的持有者自己也在等待另一把锁时, 提升会沿 "等待的锁 -> 该锁的持有者" 链继续传递,
+// 直到某一级的优先级不再变化; 超时、删除或挂起等待者时沿同一条链回落。
+// 该值限制一次传递在临界区中遍历的层数, 应不小于系统中锁的最大嵌套深度, 超出部分计入 `cat pi` 的截断次数
+#define MYRTOS_MUTEX_INHERIT_DEPTH (8)
+
+// 可调用内核 FromISR API 的最高中断优先级 (未移位的 NVIC 抢占优先级, 数值越小优先级越高)
+// 非0 = 临界区通过 BASEPRI 只屏蔽优先级数值 >= 该值的中断, 数值更小的中断构成
+//       "零延迟" 层, 永远不会被内核推迟, 但这些中断中禁止调用任何 MyRTOS API;
+//       SysTick 和 PendSV 固定为最低优先级, 所有调用 FromISR API 的中断的优先级数值必须 >= 该值
+// 0 = 临界区关闭全部中断 (PRIMASK), 与旧版本行为一致
+#define MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY (5)
+
+// 运行时可通过 MyRTOS_RegisterExtension 注册的内核扩展数量
+// 0 = 移除运行时注册表, 内核事件只分发给下面的编译期静态钩子
+#define MYRTOS_MAX_KERNEL_EXTENSIONS (8)
+
+// 编译期静态钩子: 内核对订阅的事件直接调用 MYRTOS_EXTENSION_STATIC_HOOK 指定的函数 (由应用实现),
+// 不经过函数指针; 未订阅的事件在编译期被移除。订阅掩码为0时不需要定义钩子函数
+#define MYRTOS_EXTENSION_STATIC_EVENTS (0)
+// #define MYRTOS_EXTENSION_STATIC_HOOK App_KernelEventHook
+
 /*===========================================================================*
  *                      内存配置                 *
  *===========================================================================*/
 
+// 是否启用内核内存堆
+// 1 = 启用: Task_Create/Queue_Create 等动态接口从下面的内存池中分配
+// 0 = 完全移除内存堆: 内核对象只能通过 *_CreateStatic 使用调用者提供的存储创建,
+//     启动时间和内存占用完全确定; IO/Log/Shell 等服务模块依赖内存堆, 需要一并禁用
+#define MYRTOS_USE_HEAP 1
+
+// 空闲任务的栈大小 (单位: 字), 空闲任务总是静态分配
+#define MYRTOS_IDLE_TASK_STACK (128)
+
+// 创建任务时是否用魔法数字填充整个栈
+// 1 = 填充: Monitor 可以统计每个任务的栈高水位
+// 0 = 不填充: 任务创建更快, 栈高水位始终为0
+#define MYRTOS_TASK_STACK_PAINT 1
+
+// 只读存储 (片内 Flash) 的地址范围 [START, END)
+// 任务名位于该范围内 (字符串常量) 时直接引用, 否则复制到任务自己的内存块中;
+// 两者相等表示不判断, 任务名总是被复制
+#define MYRTOS_ROM_START (0x08000000UL)
+#define MYRTOS_ROM_END (0x08080000UL)
+
 // RTOS内核管理的内存堆的总大小 (单位: 字节)
 // 所有通过 MyRTOS_Malloc() 分配的内存（如TCB, 任务栈, 队列存储区）都来自这个池
 // 大小需要根据您的应用仔细估算
@@ -60,12 +161,12 @@
  *                         配置错误检查                  *
  *===========================================================================*/
 
-#if MYRTOS_MAX_PRIORITIES > 32
-#error "MYRTOS_MAX_PRIORITIES must be less than or equal to 32."
+#if MYRTOS_MAX_PRIORITIES > 256
+#error "MYRTOS_MAX_PRIORITIES must be less than or equal to 256."
 #endif
 
-#if MYRTOS_MAX_CONCURRENT_TASKS > 64
-#error "MYRTOS_MAX_CONCURRENT_TASKS must be less than or equal to 64 due to the current taskIdBitmap implementation."
+#if MYRTOS_MAX_CONCURRENT_TASKS > 65535
+#error "MYRTOS_MAX_CONCURRENT_TASKS must be less than or equal to 65535."
 #endif
 
 #if (MYRTOS_CPU_CLOCK_HZ / MYRTOS_TICK_RATE_HZ) > 0xFFFFFF
@@ -23,22 +23,10 @@ extern void Platform_StackOverflow_Hook(TaskHandle_t pxTask);
 // ============================================================================
 //                              临界区管理
 // ============================================================================
+// MyRTOS_Port_EnterCritical/ExitCritical 内联实现于 MyRTOS_Port.h,
+// 根据 MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY 选择 BASEPRI 或 PRIMASK
 volatile UBaseType_t uxCriticalNesting = 0;
 
-void MyRTOS_Port_EnterCritical(void) {
-    __disable_irq();
-    uxCriticalNesting++;
-}
-
-void MyRTOS_Port_ExitCritical(void) {
-    if (uxCriticalNesting > 0) {
-        uxCriticalNesting--;
-        if (uxCriticalNesting == 0) {
-            __enable_irq();
-        }
-    }
-}
-
 // ============================================================================
 //                              上下文切换
 // ============================================================================
@@ -216,6 +204,101 @@ void SysTick_Handler(void) {
     MyRTOS_Port_YieldFromISR(higherPriorityTaskWoken);
 }
 
+// ============================================================================
+//                              时间戳
+// ============================================================================
+uint32_t MyRTOS_Port_GetTimestamp(void) {
+    const uint32_t countsPerTick = SystemCoreClock / MYRTOS_TICK_RATE_HZ;
+    MyRTOS_Port_EnterCritical();
+    uint32_t tick = MyRTOS_GetTick32();
+    uint32_t elapsed = (countsPerTick - 1) - SysTick->VAL;
+    // SysTick 已回绕但滴答中断尚未处理: 重新读取计数值并补上这一个Tick
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        elapsed = (countsPerTick - 1) - SysTick->VAL;
+        tick++;
+    }
+    MyRTOS_Port_ExitCritical();
+    return tick * countsPerTick + elapsed;
+}
+
+// ============================================================================
+//                           低功耗空闲模式
+// ============================================================================
+#if MYRTOS_USE_TICKLESS_IDLE == 1
+void MyRTOS_Port_SuppressTicksAndSleep(uint32_t expectedIdleTicks) {
+    const uint32_t countsPerTick = SystemCoreClock / MYRTOS_TICK_RATE_HZ;
+    const uint32_t maxSuppressedTicks = SysTick_LOAD_RELOAD_Msk / countsPerTick;
+    const uint32_t ctrlStopped = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk;
+
+    // 关中断期间 WFI 仍会被挂起的中断唤醒, 但中断服务程序要等到补偿完成后才执行
+    __disable_irq();
+    __DSB();
+    __ISB();
+    // 关中断后重新确认: 期间可能有中断唤醒了任务或改变了最近的唤醒时间
+    const uint32_t idleTicks = MyRTOS_Tick_GetExpectedIdleTicks();
+    if (idleTicks < expectedIdleTicks) {
+        expectedIdleTicks = idleTicks;
+    }
+    if (expectedIdleTicks < MYRTOS_TICKLESS_MIN_IDLE_TICKS) {
+        if (expectedIdleTicks > 0) {
+            __DSB();
+            __WFI();
+            __ISB();
+        }
+        __enable_irq();
+        return;
+    }
+    if (expectedIdleTicks > maxSuppressedTicks) {
+        expectedIdleTicks = maxSuppressedTicks;
+    }
+
+    // 暂停 SysTick, 以当前Tick剩余的计数加上 (expectedIdleTicks - 1) 个完整Tick作为新的重载值
+    SysTick->CTRL = ctrlStopped;
+    uint32_t countsLeft = SysTick->VAL;
+    if (countsLeft == 0) {
+        countsLeft = countsPerTick;
+    }
+    // 如果暂停前恰好产生了一次滴答中断, 它会在开中断后被处理, 这里少休眠一个Tick
+    const uint32_t tickPending = ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0) ? 1UL : 0UL;
+    const uint32_t reloadValue = countsLeft + countsPerTick * (expectedIdleTicks - 1UL - tickPending);
+    SysTick->LOAD = reloadValue;
+    SysTick->VAL = 0;
+    SysTick->CTRL = ctrlStopped | SysTick_CTRL_ENABLE_Msk;
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    // 醒来后再次暂停 SysTick, 计算实际经过的完整Tick数
+    SysTick->CTRL = ctrlStopped;
+    uint32_t completeTicks;
+    if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0) {
+        // 由 SysTick 唤醒: 最后一个Tick由挂起的滴答中断处理, 当前Tick从重载时刻开始计时
+        uint32_t loadValue = (countsPerTick - 1UL) - (reloadValue - SysTick->VAL);
+        if (loadValue == 0 || loadValue >= countsPerTick) {
+            loadValue = countsPerTick - 1UL;
+        }
+        SysTick->LOAD = loadValue;
+        completeTicks = expectedIdleTicks - 1UL;
+    } else {
+        // 由其他中断提前唤醒: 按已经过的计数折算完整Tick, 剩余部分作为当前Tick的长度
+        countsLeft = SysTick->VAL;
+        if (countsLeft == 0) {
+            countsLeft = reloadValue;
+        }
+        const uint32_t elapsedCounts = ((expectedIdleTicks - tickPending) * countsPerTick) - countsLeft;
+        completeTicks = elapsedCounts / countsPerTick;
+        SysTick->LOAD = ((completeTicks + 1UL) * countsPerTick) - elapsedCounts;
+    }
+    SysTick->VAL = 0;
+    SysTick->CTRL = ctrlStopped | SysTick_CTRL_ENABLE_Msk;
+    MyRTOS_Tick_Step(completeTicks);
+    // 下一次重载恢复为正常的Tick周期
+    SysTick->LOAD = countsPerTick - 1UL;
+    __enable_irq();
+}
+#endif
+
 // ============================================================================
 //                           故障处理
 // ============================================================================
@@ -21,6 +21,10 @@ extern StreamHandle_t g_system_stdout;
 extern StreamHandle_t g_system_stderr;
 #endif
 
+#if MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
+#include "MyRTOS_WorkQueue.h"
+#endif
+
 #if MYRTOS_SERVICE_ASYNC_IO_ENABLE == 1
 #include "MyRTOS_AsyncIO.h"
 #endif
@@ -113,6 +117,22 @@ static void boot_init_services(const BootConfig_t *config) {
     if (console) Stream_Printf(console, "  [OK] I/O streams\r\n");
 #endif
 
+    // 工作队列服务 (其他服务可以把后台工作交给它执行, 需要先于这些服务初始化)
+#if MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
+    if (WorkQueue_Init() != 0) {
+#if MYRTOS_SERVICE_IO_ENABLE == 1
+        if (console) Stream_Printf(console, "  [FAIL] Work queue\r\n");
+#endif
+        while (1);
+    }
+#if MYRTOS_SERVICE_IO_ENABLE == 1
+    if (console) Stream_Printf(console, "  [OK] Work queue (levels: %d, workers: %d, prio: %d)\r\n",
+                              MYRTOS_WORKQUEUE_LEVELS,
+                              MYRTOS_WORKQUEUE_LEVELS * MYRTOS_WORKQUEUE_WORKERS_PER_LEVEL,
+                              MYRTOS_WORKQUEUE_BASE_PRIORITY);
+#endif
+#endif
+
     // 异步 I/O 服务
 #if MYRTOS_SERVICE_ASYNC_IO_ENABLE == 1
     if (AsyncIOService_Init() != 0) {
@@ -121,7 +141,11 @@ static void boot_init_services(const BootConfig_t *config) {
 #endif
         while (1);
     }
-#if MYRTOS_SERVICE_IO_ENABLE == 1
+#if MYRTOS_SERVICE_IO_ENABLE == 1 && MYRTOS_ASYNCIO_USE_WORKQUEUE == 1
+    if (console) Stream_Printf(console, "  [OK] Async I/O (queue: %d, work queue level: %d)\r\n",
+                              MYRTOS_ASYNCIO_QUEUE_LENGTH,
+                              MYRTOS_ASYNCIO_WORK_LEVEL);
+#elif MYRTOS_SERVICE_IO_ENABLE == 1
     if (console) Stream_Printf(console, "  [OK] Async I/O (queue: %d, prio: %d)\r\n",
                               MYRTOS_ASYNCIO_QUEUE_LENGTH,
                               MYRTOS_ASYNCIO_TASK_PRIORITY);
@@ -206,7 +230,11 @@ static void boot_init_services(const BootConfig_t *config) {
 static void boot_default_idle_task(void *pv) {
     (void) pv;
     for (;;) {
+#if MYRTOS_USE_TICKLESS_IDLE == 1
+        MyRTOS_Idle_Sleep();
+#else
         // 默认什么都不做，等待调度
+#endif
     }
 }
 
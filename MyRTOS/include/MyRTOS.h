@@ -5,6 +5,98 @@
 #include <stdint.h>
 #include "MyRTOS_Config.h"
 
+// -----------------------------
+// 可选功能默认配置
+// -----------------------------
+// 低功耗空闲模式 (Tickless Idle): 所有任务阻塞时停止周期性的 SysTick 中断
+#ifndef MYRTOS_USE_TICKLESS_IDLE
+#define MYRTOS_USE_TICKLESS_IDLE 0
+#endif
+// 进入低功耗空闲模式所需的最少空闲Tick数, 更短的空闲只执行普通的 WFI
+#ifndef MYRTOS_TICKLESS_MIN_IDLE_TICKS
+#define MYRTOS_TICKLESS_MIN_IDLE_TICKS 2
+#endif
+// 最早截止时间优先 (EDF) 调度类: 指定优先级上的任务按绝对截止时间排序, 其余优先级仍为固定优先级调度
+#ifndef MYRTOS_USE_EDF
+#define MYRTOS_USE_EDF 0
+#endif
+// EDF 调度类占用的优先级, 该优先级只应用于 Task_CreateEDF 创建的任务
+#ifndef MYRTOS_EDF_PRIORITY
+#define MYRTOS_EDF_PRIORITY (MYRTOS_MAX_PRIORITIES / 2)
+#endif
+// CPU预算服务器: 任务每个周期最多运行指定的Tick数, 用完后被挂起到下一个周期开始
+#ifndef MYRTOS_USE_BUDGET
+#define MYRTOS_USE_BUDGET 0
+#endif
+// 同步原语快速路径: 无竞争的互斥锁/信号量操作用独占访问指令完成, 不进入临界区 (仅对支持的移植层生效)
+#ifndef MYRTOS_USE_SYNC_FAST_PATH
+#define MYRTOS_USE_SYNC_FAST_PATH 0
+#endif
+// 优先级继承沿 "等待互斥锁 -> 该锁的持有者" 链传递的最大深度, 限制临界区中链遍历的长度
+#ifndef MYRTOS_MUTEX_INHERIT_DEPTH
+#define MYRTOS_MUTEX_INHERIT_DEPTH 8
+#endif
+#if MYRTOS_USE_EDF == 1 && (MYRTOS_EDF_PRIORITY <= 0 || MYRTOS_EDF_PRIORITY >= MYRTOS_MAX_PRIORITIES)
+#error "MYRTOS_EDF_PRIORITY must be in [1, MYRTOS_MAX_PRIORITIES - 1]."
+#endif
+// 中断延迟调用 (下半部): 中断把函数投递到无锁队列, 由高优先级守护任务执行
+#ifndef MYRTOS_USE_DEFERRED_CALL
+#define MYRTOS_USE_DEFERRED_CALL 0
+#endif
+// 延迟调用队列长度, 必须是2的幂
+#ifndef MYRTOS_DEFERRED_QUEUE_LENGTH
+#define MYRTOS_DEFERRED_QUEUE_LENGTH 32
+#endif
+// 延迟调用统计的来源数
+#ifndef MYRTOS_DEFERRED_MAX_SOURCES
+#define MYRTOS_DEFERRED_MAX_SOURCES 8
+#endif
+// 延迟调用守护任务的优先级和栈大小(字)
+#ifndef MYRTOS_DEFERRED_TASK_PRIORITY
+#define MYRTOS_DEFERRED_TASK_PRIORITY (MYRTOS_MAX_PRIORITIES - 1)
+#endif
+#ifndef MYRTOS_DEFERRED_TASK_STACK
+#define MYRTOS_DEFERRED_TASK_STACK 256
+#endif
+// EventGroup_SetBitsFromISR 投递延迟调用时使用的来源编号
+#ifndef MYRTOS_EVENT_GROUP_DEFER_SOURCE
+#define MYRTOS_EVENT_GROUP_DEFER_SOURCE (MYRTOS_DEFERRED_MAX_SOURCES - 1)
+#endif
+// 可调用内核 API 的最高中断优先级 (未移位的 NVIC 优先级); 0 表示临界区关闭全部中断
+#ifndef MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY
+#define MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY 0
+#endif
+// 运行时可注册的内核扩展数量; 为0时移除注册表, 内核事件只分发给编译期静态钩子
+#ifndef MYRTOS_MAX_KERNEL_EXTENSIONS
+#define MYRTOS_MAX_KERNEL_EXTENSIONS 8
+#endif
+// 编译期静态钩子订阅的内核事件掩码, 非0时必须同时定义 MYRTOS_EXTENSION_STATIC_HOOK 为钩子函数名
+#ifndef MYRTOS_EXTENSION_STATIC_EVENTS
+#define MYRTOS_EXTENSION_STATIC_EVENTS 0
+#endif
+#if MYRTOS_EXTENSION_STATIC_EVENTS != 0 && !defined(MYRTOS_EXTENSION_STATIC_HOOK)
+#error "MYRTOS_EXTENSION_STATIC_HOOK must name a function when MYRTOS_EXTENSION_STATIC_EVENTS is non-zero."
+#endif
+// 内核内存堆: 为0时移除 MyRTOS_Malloc/Free 和所有动态创建接口, 内核对象只能通过 *_CreateStatic 创建
+#ifndef MYRTOS_USE_HEAP
+#define MYRTOS_USE_HEAP 1
+#endif
+// 空闲任务的栈大小(字), 空闲任务总是静态分配
+#ifndef MYRTOS_IDLE_TASK_STACK
+#define MYRTOS_IDLE_TASK_STACK 128
+#endif
+// 创建任务时用魔法数字填充整个栈, 用于统计栈的最大使用量; 为0时创建更快, 但栈高水位不可用
+#ifndef MYRTOS_TASK_STACK_PAINT
+#define MYRTOS_TASK_STACK_PAINT 1
+#endif
+// 只读存储 (Flash) 的地址范围 [START, END), 位于其中的任务名直接引用而不复制; 两者相等表示不启用
+#ifndef MYRTOS_ROM_START
+#define MYRTOS_ROM_START 0
+#endif
+#ifndef MYRTOS_ROM_END
+#define MYRTOS_ROM_END 0
+#endif
+
 // -----------------------------
 // 时间转换宏
 // -----------------------------
@@ -40,6 +132,7 @@ struct Task_t;
 struct Mutex_t;
 struct Queue_t;
 struct Semaphore_t;
+struct EventGroup_t;
 
 // -----------------------------
 // 任务状态枚举
@@ -75,6 +168,154 @@ typedef struct Task_t *TaskHandle_t; // 任务句柄
 typedef struct Mutex_t *MutexHandle_t; // 互斥锁句柄
 typedef void *QueueHandle_t; // 队列句柄
 typedef struct Semaphore_t *SemaphoreHandle_t; // 信号量句柄
+typedef struct EventGroup_t *EventGroupHandle_t; // 事件组句柄
+typedef uint32_t TaskRef_t; // 任务引用: 高16位为槽位代数, 低16位为任务ID, 可安全地长期保存
+
+/**
+ * @brief 内核对象等待队列的排队顺序
+ */
+typedef enum {
+    WAIT_ORDER_PRIORITY = 0, // 按优先级从高到低唤醒, 同优先级先到先得 (默认)
+    WAIT_ORDER_FIFO, // 严格按到达顺序唤醒, 与优先级无关
+} WaitOrder_t;
+
+/**
+ * @brief 互斥锁的释放方式
+ */
+typedef enum {
+    MUTEX_RELEASE_HANDOFF = 0, // 释放时把所有权直接交给等待队列头部的任务 (默认)
+    MUTEX_RELEASE_COMPETITIVE, // 释放时只唤醒等待者, 由它运行后与其他任务重新竞争
+} MutexReleaseMode_t;
+
+/**
+ * @brief 互斥锁的统计信息 (优先级继承、优先级天花板与竞争释放)
+ */
+typedef struct {
+    uint32_t boosts; // 因优先级继承提升任务优先级的次数
+    uint32_t transitiveBoosts; // 其中沿互斥锁链传递给间接持有者的次数
+    uint32_t depthLimitHits; // 传递因达到 MYRTOS_MUTEX_INHERIT_DEPTH 而截断的次数
+    uint32_t maxDepth; // 观察到的最长传递深度 (直接持有者为1)
+    uint32_t ceilingViolations; // 基础优先级高于天花板的任务获取天花板互斥锁被拒绝的次数
+    uint32_t competitiveWakeups; // 竞争释放唤醒等待者的次数
+    uint32_t convoysAvoided; // 被唤醒的等待者运行时锁已被其他任务重新获取的次数 (避免了一次锁护航)
+} MutexStats_t;
+
+/**
+ * @brief 内核对象观察者
+ * @details 挂在队列或信号量上, 对象变为可用 (队列写入数据、信号量计数增加) 时内核向 task 发送 signal 信号,
+ *          并把观察者从对象上摘下 (一次性)。观察者不占有对象, 收到信号后仍需以不阻塞的方式重新获取,
+ *          可能被其他任务抢先。存储由调用者提供, 同一时刻只能挂在一个对象上;
+ *          对象删除时所有观察者都会收到信号。task 被删除之前必须先取消它的观察者。
+ */
+typedef struct ObjectWatch_t {
+    struct ObjectWatch_t *next; // 对象观察者链表的下一节点
+    struct ObjectWatch_t **volatile pList; // 所在对象的观察者链表头, 未挂载时为NULL
+    TaskHandle_t task; // 对象可用时接收信号的任务
+    uint32_t signal; // 发送给 task 的信号位
+} ObjectWatch_t;
+
+// -----------------------------
+// 静态分配的内核对象存储
+// -----------------------------
+/*
+ * 以下类型只用于为 *_CreateStatic 接口提供大小和对齐正确的存储空间, 成员没有任何意义, 不得访问。
+ * 它们按相同的成员顺序镜像内核内部的结构体, 两者不一致时内核会在编译期报错。
+ */
+
+/**
+ * @brief 事件列表的静态存储 (只作为其他静态存储类型的成员)
+ */
+typedef struct {
+    void *dummy1[2];
+    uint8_t dummy2;
+} StaticEventList_t;
+
+/**
+ * @brief 任务控制块的静态存储
+ */
+typedef struct {
+    void *dummy1[3];
+    uint64_t dummy2;
+    uint32_t dummy3;
+    uint8_t dummy4;
+    uint32_t dummy5[3];
+    StaticEventList_t dummy6;
+    TaskState_t dummy7;
+    uint32_t dummy8;
+    uint16_t dummy9;
+    void *dummy10;
+    uint8_t dummy11[3];
+    uint32_t dummy12[7];
+#if MYRTOS_USE_EDF == 1
+    uint64_t dummy13[2];
+    uint32_t dummy14[3];
+#endif
+#if MYRTOS_USE_BUDGET == 1
+    uint64_t dummy15;
+    uint32_t dummy16[4];
+#endif
+    void *dummy17[12];
+    uint16_t dummy18;
+    uint8_t dummy19;
+} StaticTask_t;
+
+/**
+ * @brief 队列控制块的静态存储
+ */
+typedef struct {
+    void *dummy1;
+    uint32_t dummy2[3];
+    void *dummy3[2];
+    StaticEventList_t dummy4[2];
+    void *dummy5;
+    uint8_t dummy6;
+} StaticQueue_t;
+
+/**
+ * @brief 互斥锁控制块的静态存储
+ */
+typedef struct {
+    void *dummy1[2];
+    StaticEventList_t dummy2;
+    uint32_t dummy3;
+    uint8_t dummy4[5];
+} StaticMutex_t;
+
+/**
+ * @brief 信号量控制块的静态存储
+ */
+typedef struct {
+    uint32_t dummy1[2];
+    StaticEventList_t dummy2;
+    void *dummy3;
+    uint8_t dummy4;
+} StaticSemaphore_t;
+
+/**
+ * @brief 事件组控制块的静态存储
+ */
+typedef struct {
+    uint32_t dummy1[2];
+    StaticEventList_t dummy2;
+    uint8_t dummy3[2];
+} StaticEventGroup_t;
+
+#if MYRTOS_USE_DEFERRED_CALL == 1
+typedef void (*DeferredFunc_t)(void *arg); // 延迟调用函数
+
+/**
+ * @brief 延迟调用的来源统计信息
+ * @note  时间单位为 MyRTOS_Port_GetTimestamp 的计数 (CPU周期)。
+ */
+typedef struct {
+    uint32_t posted; // 成功投递的次数
+    uint32_t dropped; // 因队列已满被丢弃的次数
+    uint32_t executed; // 已执行的次数
+    uint32_t maxLatency; // 从投递到开始执行的最大延迟
+    uint64_t totalLatency; // 延迟累计值, 除以 executed 得到平均延迟
+    uint32_t maxRunTime; // 单次执行的最长耗时
+} DeferredStats_t;
+#endif
 
 // -----------------------------
 // 全局内核变量
@@ -106,10 +347,26 @@ void Task_StartScheduler(void (*idle_task_hook)(void *));
 
 /**
  * @brief 获取系统当前时钟节拍数
+ * @note  无锁读取, 不关中断
  * @return 当前系统时钟节拍数
  */
 uint64_t MyRTOS_GetTick(void);
 
+/**
+ * @brief 获取系统当前时钟节拍数的低32位
+ * @note  开销最低的时间读取接口, 适用于只关心相对时间的场合, 配合 MyRTOS_TickElapsed32 使用
+ * @return 当前系统时钟节拍数的低32位
+ */
+uint32_t MyRTOS_GetTick32(void);
+
+/**
+ * @brief 计算从某个32位时钟节拍数到现在经过的节拍数
+ * @note  基于无符号减法, 计数回绕时结果仍然正确, 只要间隔小于 2^32 个节拍
+ * @param start 起始时刻, 由 MyRTOS_GetTick32 获得
+ * @return 经过的节拍数
+ */
+static inline uint32_t MyRTOS_TickElapsed32(uint32_t start) { return MyRTOS_GetTick32() - start; }
+
 /**
  * @brief 系统时钟节拍处理函数
  * @details 由系统定时器中断调用，用于更新系统时钟和处理延时任务
@@ -122,6 +379,72 @@ int MyRTOS_Tick_Handler(void);
  */
 uint8_t MyRTOS_Schedule_IsRunning(void);
 
+/**
+ * @brief 锁定调度器 (可嵌套)
+ * @details 锁定期间不关中断, 但推迟所有上下文切换, 最外层解锁时补发。
+ *          适合保护耗时较长、只在任务中访问的数据; 锁定期间禁止调用会阻塞的 API
+ */
+void MyRTOS_Schedule_Lock(void);
+
+/**
+ * @brief 解锁调度器
+ * @details 与 MyRTOS_Schedule_Lock 成对调用
+ */
+void MyRTOS_Schedule_Unlock(void);
+
+#if MYRTOS_USE_TICKLESS_IDLE == 1
+/**
+ * @brief 空闲任务的低功耗休眠入口
+ * @details 在空闲任务循环中调用以代替 WFI。若所有任务都处于阻塞状态, 会把 SysTick
+ *          重新编程到最近的任务唤醒时间并休眠, 醒来后补偿系统滴答计数。
+ */
+void MyRTOS_Idle_Sleep(void);
+
+/**
+ * @brief 计算空闲任务可以连续休眠的Tick数 (供移植层在关中断时调用)
+ * @details 在中断开启时调用的结果只是一个提示, 移植层必须在关中断后重新计算。
+ * @return 可休眠的Tick数, 0 表示不能休眠
+ */
+uint32_t MyRTOS_Tick_GetExpectedIdleTicks(void);
+
+/**
+ * @brief 补偿低功耗休眠期间被跳过的Tick (供移植层在关中断时调用)
+ * @param ticks 被跳过的完整Tick数
+ */
+void MyRTOS_Tick_Step(uint32_t ticks);
+
+/**
+ * @brief 获取低功耗空闲模式累计跳过的Tick数
+ * @return 被跳过 (未产生 SysTick 中断) 的Tick总数
+ */
+uint64_t MyRTOS_GetSuppressedTicks(void);
+#endif
+
+#if MYRTOS_USE_DEFERRED_CALL == 1
+/**
+ * @brief 从中断中投递一个延迟调用, 由延迟调用守护任务按 FIFO 顺序执行
+ * @note  队列操作无锁, 不修改内核链表, 也可在任务中调用。
+ * @param source 投递来源编号 (< MYRTOS_DEFERRED_MAX_SOURCES), 用于分类统计
+ * @param func 在守护任务上下文中执行的函数
+ * @param arg 函数参数
+ * @return 成功返回0; 队列已满或参数无效返回-1
+ */
+int MyRTOS_DeferFromISR(uint32_t source, DeferredFunc_t func, void *arg);
+
+/**
+ * @brief 获取一个投递来源的延迟调用统计信息
+ * @param source 投递来源编号
+ * @param stats_out [out] 统计信息
+ * @return 成功返回0，来源编号无效返回-1
+ */
+int MyRTOS_Deferred_GetStats(uint32_t source, DeferredStats_t *stats_out);
+
+/**
+ * @brief 清零所有来源的延迟调用统计信息
+ */
+void MyRTOS_Deferred_ResetStats(void);
+#endif
+
 /**
  * @brief 报告内核严重错误。
  *        此函数由平台层或内部检查调用，用于通知内核发生了致命事件，
@@ -133,6 +456,7 @@ uint8_t MyRTOS_Schedule_IsRunning(void);
 
 void MyRTOS_ReportError(KernelErrorType_t error_type, void *p_context);
 
+#if MYRTOS_USE_HEAP == 1
 // =============================
 // 内核内存管理 API
 // =============================
@@ -148,10 +472,12 @@ void *MyRTOS_Malloc(size_t wantedSize);
  * @param pv 指向需要释放的内存块的指针
  */
 void MyRTOS_Free(void *pv);
+#endif
 
 // =============================
 // 任务管理 API
 // =============================
+#if MYRTOS_USE_HEAP == 1
 /**
  * @brief 创建一个新任务
  * @param func 任务函数指针
@@ -163,6 +489,23 @@ void MyRTOS_Free(void *pv);
  */
 TaskHandle_t Task_Create(void (*func)(void *), const char *taskName, uint16_t stack_size, void *param,
                          uint8_t priority);
+#endif
+
+/**
+ * @brief 使用调用者提供的TCB和栈创建一个新任务
+ * @details 创建过程不分配任何内存, 任务删除时也不释放这两块存储。任务名不会被复制,
+ *          taskName 必须在任务的整个生命周期内有效 (通常是字符串常量)。
+ * @param func 任务函数指针
+ * @param taskName 任务名称, NULL 表示使用 "Unnamed"
+ * @param stack_size 任务堆栈大小（以StackType_t为单位）
+ * @param param 传递给任务函数的参数
+ * @param priority 任务优先级
+ * @param stack_buffer 任务栈, 至少 stack_size 个 StackType_t, 可以放在专用的链接段中
+ * @param tcb_buffer 任务控制块存储
+ * @return 成功时返回任务句柄，失败时返回NULL
+ */
+TaskHandle_t Task_CreateStatic(void (*func)(void *), const char *taskName, uint16_t stack_size, void *param,
+                               uint8_t priority, void *stack_buffer, StaticTask_t *tcb_buffer);
 
 /**
  * @brief 删除指定任务
@@ -177,6 +520,95 @@ int Task_Delete(TaskHandle_t task_h);
  */
 void Task_Delay(uint32_t tick);
 
+/**
+ * @brief 将当前任务延迟到下一个周期释放点 (绝对时间)
+ * @details 释放点按 *previous_wake + period 计算, 与任务实际被唤醒、运行的时刻无关,
+ *          因此周期循环不会因调度延迟而漂移。每次按时释放后, 任务的释放抖动
+ *          (实际开始运行的Tick - 预定释放Tick) 计入统计, 可通过 Monitor 服务查看。
+ *          若调用时下一个释放点已经过去 (超期), 任务不阻塞, 超期计数加一,
+ *          已经错过的释放点被跳过, 任务重新对齐到原来的周期相位上。
+ * @code
+ *   uint64_t last_wake = MyRTOS_GetTick();
+ *   for (;;) {
+ *       do_work();
+ *       Task_DelayUntil(&last_wake, MS_TO_TICKS(10));
+ *   }
+ * @endcode
+ * @param previous_wake [in,out] 上一个释放点, 首次调用前用 MyRTOS_GetTick() 初始化, 返回时更新为本次释放点
+ * @param period 周期(Tick), 不能为0
+ * @return 跳过的释放点个数, 0 表示按时释放
+ */
+uint32_t Task_DelayUntil(uint64_t *previous_wake, uint32_t period);
+
+/**
+ * @brief 当前任务主动让出CPU
+ * @details 当前任务被移动到同优先级就绪队列的末尾, 同优先级的其他就绪任务获得运行机会。
+ */
+void Task_Yield(void);
+
+/**
+ * @brief 设置任务的时间片长度
+ * @details 同优先级的任务之间只在时间片耗尽时 (由系统滴答中断判断) 轮转,
+ *          新建任务的默认值为 MYRTOS_DEFAULT_TIME_SLICE。
+ * @param task_h 目标任务句柄, NULL 表示当前任务
+ * @param ticks 时间片长度(Tick), 0 表示不参与轮转, 一直运行到阻塞或主动让出
+ */
+void Task_SetTimeSlice(TaskHandle_t task_h, uint32_t ticks);
+
+/**
+ * @brief 设置任务的抢占阈值
+ * @details 任务运行时, 只有优先级高于阈值的任务才能抢占它; 优先级介于两者之间的任务
+ *          要等它阻塞或让出后才能运行, 用于减少协作任务之间不必要的上下文切换。
+ *          新建任务的阈值等于其优先级 (即普通的抢占式调度)。优先级继承把任务优先级提升到阈值以上时,
+ *          以提升后的优先级为准。
+ * @param task_h 目标任务句柄, NULL 表示当前任务
+ * @param threshold 抢占阈值, 不能低于任务的基础优先级
+ * @return 0表示成功，-1表示参数无效
+ */
+int Task_SetPreemptionThreshold(TaskHandle_t task_h, uint8_t threshold);
+
+#if MYRTOS_USE_BUDGET == 1
+/**
+ * @brief 为任务设置CPU预算 (可延迟服务器)
+ * @details 任务在每个周期内最多运行 budget_ticks 个Tick, 预算在周期边界一次性补满。
+ *          预算用完后任务被挂起到当前周期结束, 由系统滴答中断强制执行。
+ *          持有互斥锁或锁住调度器的任务会先运行到释放为止, 超出部分计入本周期的用量。
+ * @param task_h 目标任务句柄, NULL 表示当前任务
+ * @param budget_ticks 每个周期的预算(Tick), 0 表示取消预算限制
+ * @param period_ticks 周期(Tick), 不能小于预算
+ * @return 0表示成功，-1表示参数无效
+ */
+int Task_SetBudget(TaskHandle_t task_h, uint32_t budget_ticks, uint32_t period_ticks);
+#endif
+
+#if MYRTOS_USE_EDF == 1 && MYRTOS_USE_HEAP == 1
+/**
+ * @brief 创建一个EDF调度类的周期任务
+ * @note  任务运行在 MYRTOS_EDF_PRIORITY 优先级上, 同一优先级内按当前作业的绝对截止时间排序,
+ *        截止时间越早越先运行。首个作业在创建时释放。
+ * @param func 任务函数指针
+ * @param taskName 任务名称-字符串
+ * @param stack_size 任务堆栈大小（以StackType_t为单位）
+ * @param param 传递给任务函数的参数
+ * @param relative_deadline 相对截止时间(Tick), 作业释放后必须在此时间内完成, 不能为0
+ * @param period 周期(Tick), 相邻两个作业释放时间的间隔, 不能为0
+ * @return 成功则返回任务句柄，失败则返回NULL
+ */
+TaskHandle_t Task_CreateEDF(void (*func)(void *), const char *taskName, uint16_t stack_size, void *param,
+                            uint32_t relative_deadline, uint32_t period);
+#endif
+
+#if MYRTOS_USE_EDF == 1
+
+/**
+ * @brief 结束EDF任务的当前作业并等待下一个周期
+ * @note  若当前时间已超过作业的截止时间, 任务的截止时间错过计数加一。
+ *        已经错过的释放点会被跳过, 任务始终对齐到创建时确定的周期相位上。
+ *        非EDF任务调用此函数没有任何效果。
+ */
+void Task_WaitForNextPeriod(void);
+#endif
+
 
 /**
  * @brief 挂起指定的任务.
@@ -256,6 +688,13 @@ uint32_t Task_WaitSignal(uint32_t signal_mask, uint32_t block_ticks, uint32_t op
  */
 int Task_ClearSignal(TaskHandle_t task_to_clear, uint32_t signals_to_clear);
 
+/**
+ * @brief 取消一个内核对象观察者
+ * @details 观察者已经触发或未挂载时什么也不做。
+ * @param watch 观察者 (由 Queue_Watch 或 Semaphore_Watch 挂载)
+ */
+void ObjectWatch_Cancel(ObjectWatch_t *watch);
+
 
 
 /**
@@ -285,6 +724,29 @@ TaskHandle_t Task_GetCurrentTaskHandle(void);
  */
 uint32_t Task_GetId(TaskHandle_t task_h);
 
+/**
+ * @brief 根据任务ID查找任务句柄, O(1)
+ * @param id 任务ID (即 Task_GetId 的返回值)
+ * @return 该ID当前对应的任务句柄, ID未被使用时返回 NULL
+ */
+TaskHandle_t Task_GetById(uint32_t id);
+
+/**
+ * @brief 获取任务的引用值
+ * @note  任务ID在任务删除后会被复用, 而引用值额外携带了槽位的代数,
+ *        旧任务的引用在槽位被复用后不会再解析到新任务上。
+ * @param task_h 任务句柄, NULL 表示当前任务
+ * @return 任务引用值
+ */
+TaskRef_t Task_GetRef(TaskHandle_t task_h);
+
+/**
+ * @brief 将任务引用解析为任务句柄, O(1)
+ * @param ref 由 Task_GetRef 获取的引用值
+ * @return 任务仍然存在时返回其句柄, 任务已被删除(引用过期)时返回 NULL
+ */
+TaskHandle_t Task_FromRef(TaskRef_t ref);
+
 /**
  * @brief 获取任务的名称。
  * @param task_h 要查询的任务句柄, NULL 表示当前任务
@@ -303,6 +765,7 @@ TaskHandle_t Task_FindByName(const char *taskName);
 // =============================
 // 队列管理 API
 // =============================
+#if MYRTOS_USE_HEAP == 1
 /**
  * @brief 创建一个队列
  * @param length 队列长度(可存储的项目数)
@@ -310,6 +773,18 @@ TaskHandle_t Task_FindByName(const char *taskName);
  * @return 成功时返回队列句柄，失败时返回NULL
  */
 QueueHandle_t Queue_Create(uint32_t length, uint32_t itemSize);
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块和存储区创建一个队列
+ * @param length 队列长度(可存储的项目数)
+ * @param itemSize 队列中每个项目的大小(字节)
+ * @param storage_buffer 存储区, 至少 length * itemSize 字节
+ * @param queue_buffer 队列控制块存储
+ * @return 成功时返回队列句柄，失败时返回NULL
+ */
+QueueHandle_t Queue_CreateStatic(uint32_t length, uint32_t itemSize, uint8_t *storage_buffer,
+                                 StaticQueue_t *queue_buffer);
 
 /**
  * @brief 删除指定队列
@@ -317,6 +792,15 @@ QueueHandle_t Queue_Create(uint32_t length, uint32_t itemSize);
  */
 void Queue_Delete(QueueHandle_t delQueue);
 
+/**
+ * @brief 设置队列发送和接收等待队列的排队顺序
+ * @note  只能在没有任务等待该队列时调用 (通常紧跟在创建之后)。
+ * @param queue 队列句柄
+ * @param order 排队顺序
+ * @return 0表示成功，-1表示句柄无效或已有任务在等待
+ */
+int Queue_SetWaitOrder(QueueHandle_t queue, WaitOrder_t order);
+
 /**
  * @brief 向队列发送数据
  * @param queue 队列句柄
@@ -335,14 +819,52 @@ int Queue_Send(QueueHandle_t queue, const void *item, uint32_t block_ticks);
  */
 int Queue_Receive(QueueHandle_t queue, void *buffer, uint32_t block_ticks);
 
+/**
+ * @brief 在队列上挂载观察者, 队列写入数据时通知观察者的任务
+ * @details 供不能阻塞的等待者 (如协程) 使用: 接收失败后挂载观察者, 再等待观察者的信号。
+ *          挂载与检查在同一个临界区内完成, 队列中已有数据时不挂载, 不会丢失通知。
+ * @param queue 队列句柄
+ * @param watch 观察者, task 和 signal 成员由调用者填写, 不能已挂在其他对象上
+ * @return 0表示已挂载，1表示队列中已有数据 (未挂载)，-1表示参数无效
+ */
+int Queue_Watch(QueueHandle_t queue, ObjectWatch_t *watch);
+
 // =============================
 // 互斥锁管理 API
 // =============================
+#if MYRTOS_USE_HEAP == 1
 /**
  * @brief 创建一个互斥锁
  * @return 成功时返回互斥锁句柄，失败时返回NULL
  */
 MutexHandle_t Mutex_Create(void);
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块创建一个互斥锁
+ * @param mutex_buffer 互斥锁控制块存储
+ * @return 成功时返回互斥锁句柄，失败时返回NULL
+ */
+MutexHandle_t Mutex_CreateStatic(StaticMutex_t *mutex_buffer);
+
+#if MYRTOS_USE_HEAP == 1
+/**
+ * @brief 创建一个优先级天花板互斥锁
+ * @note  立即天花板协议: 任务获取锁时优先级立即提升到天花板, 释放时恢复, 不扫描任何等待队列。
+ *        天花板应不低于所有使用者的最高优先级; 持有期间不阻塞时, 天花板互斥锁之间不会死锁。
+ * @param ceiling 优先级天花板, 范围 [1, MYRTOS_MAX_PRIORITIES - 1]
+ * @return 成功时返回互斥锁句柄，失败时返回NULL
+ */
+MutexHandle_t Mutex_CreateCeiling(uint8_t ceiling);
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块创建一个优先级天花板互斥锁
+ * @param mutex_buffer 互斥锁控制块存储
+ * @param ceiling 优先级天花板, 范围 [1, MYRTOS_MAX_PRIORITIES - 1]
+ * @return 成功时返回互斥锁句柄，失败时返回NULL
+ */
+MutexHandle_t Mutex_CreateCeilingStatic(StaticMutex_t *mutex_buffer, uint8_t ceiling);
 
 /**
  * @brief 删除指定互斥锁
@@ -350,6 +872,26 @@ MutexHandle_t Mutex_Create(void);
  */
 void Mutex_Delete(MutexHandle_t mutex);
 
+/**
+ * @brief 设置互斥锁等待队列的排队顺序
+ * @note  只能在没有任务等待该互斥锁时调用。先进先出顺序下优先级继承仍然生效。
+ * @param mutex 互斥锁句柄
+ * @param order 排队顺序
+ * @return 0表示成功，-1表示句柄无效或已有任务在等待
+ */
+int Mutex_SetWaitOrder(MutexHandle_t mutex, WaitOrder_t order);
+
+/**
+ * @brief 设置互斥锁的释放方式
+ * @note  竞争释放时, 释放者只唤醒等待队列头部的任务而不转交所有权。释放者 (或其他正在运行的任务)
+ *        紧接着再次获取时不必阻塞在一个尚未运行的等待者后面, 避免了锁护航和成倍的上下文切换;
+ *        代价是等待者可能被 "插队", 不再保证按等待顺序获得锁。被唤醒的等待者重新等待时保留原来的超时时刻。
+ * @param mutex 互斥锁句柄
+ * @param mode 释放方式
+ * @return 0表示成功，-1表示参数无效
+ */
+int Mutex_SetReleaseMode(MutexHandle_t mutex, MutexReleaseMode_t mode);
+
 /**
  * @brief 获取互斥锁(阻塞)
  * @param mutex 互斥锁句柄
@@ -384,9 +926,16 @@ void Mutex_Lock_Recursive(MutexHandle_t mutex);
  */
 void Mutex_Unlock_Recursive(MutexHandle_t mutex);
 
+/**
+ * @brief 获取互斥锁的统计信息
+ * @param stats_out [out] 统计信息
+ */
+void Mutex_GetStats(MutexStats_t *stats_out);
+
 // =============================
 // 信号量管理 API
 // =============================
+#if MYRTOS_USE_HEAP == 1
 /**
  * @brief 创建一个信号量
  * @param maxCount 信号量最大计数值
@@ -394,6 +943,17 @@ void Mutex_Unlock_Recursive(MutexHandle_t mutex);
  * @return 成功时返回信号量句柄，失败时返回NULL
  */
 SemaphoreHandle_t Semaphore_Create(uint32_t maxCount, uint32_t initialCount);
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块创建一个信号量
+ * @param maxCount 信号量最大计数值
+ * @param initialCount 信号量初始计数值
+ * @param semaphore_buffer 信号量控制块存储
+ * @return 成功时返回信号量句柄，失败时返回NULL
+ */
+SemaphoreHandle_t Semaphore_CreateStatic(uint32_t maxCount, uint32_t initialCount,
+                                         StaticSemaphore_t *semaphore_buffer);
 
 /**
  * @brief 删除指定信号量
@@ -401,6 +961,15 @@ SemaphoreHandle_t Semaphore_Create(uint32_t maxCount, uint32_t initialCount);
  */
 void Semaphore_Delete(SemaphoreHandle_t semaphore);
 
+/**
+ * @brief 设置信号量等待队列的排队顺序
+ * @note  只能在没有任务等待该信号量时调用。
+ * @param semaphore 信号量句柄
+ * @param order 排队顺序
+ * @return 0表示成功，-1表示句柄无效或已有任务在等待
+ */
+int Semaphore_SetWaitOrder(SemaphoreHandle_t semaphore, WaitOrder_t order);
+
 /**
  * @brief 获取信号量
  * @param semaphore 信号量句柄
@@ -424,5 +993,90 @@ int Semaphore_Give(SemaphoreHandle_t semaphore);
  */
 int Semaphore_GiveFromISR(SemaphoreHandle_t semaphore, int *higherPriorityTaskWoken);
 
+/**
+ * @brief 在信号量上挂载观察者, 信号量计数增加时通知观察者的任务
+ * @details 用法与 Queue_Watch 相同。有观察者时释放操作不走无锁快速路径。
+ * @param semaphore 信号量句柄
+ * @param watch 观察者, task 和 signal 成员由调用者填写, 不能已挂在其他对象上
+ * @return 0表示已挂载，1表示信号量计数大于0 (未挂载)，-1表示参数无效
+ */
+int Semaphore_Watch(SemaphoreHandle_t semaphore, ObjectWatch_t *watch);
+
+// =============================
+// 事件组管理 API
+// =============================
+#if MYRTOS_USE_HEAP == 1
+/**
+ * @brief 创建一个事件组, 所有事件位初始为0
+ * @return 成功时返回事件组句柄，失败时返回NULL
+ */
+EventGroupHandle_t EventGroup_Create(void);
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块创建一个事件组
+ * @param group_buffer 事件组控制块存储
+ * @return 成功时返回事件组句柄，失败时返回NULL
+ */
+EventGroupHandle_t EventGroup_CreateStatic(StaticEventGroup_t *group_buffer);
+
+/**
+ * @brief 删除指定事件组, 所有等待者返回0
+ * @note  中断置位的延迟调用尚未执行时, 控制块的释放推迟到该延迟调用中完成;
+ *        静态创建的事件组在此之前不得重新使用其存储。删除之后不得再对该句柄调用任何接口。
+ * @param group 要删除的事件组句柄
+ */
+void EventGroup_Delete(EventGroupHandle_t group);
+
+/**
+ * @brief 置位事件位
+ * @details 与逐个调用 Task_SendSignal 不同, 一次置位在同一个临界区内唤醒所有条件满足的等待者,
+ *          最多触发一次调度。被唤醒的等待者要求退出时清除的位在全部唤醒之后才清除。
+ * @param group 事件组句柄
+ * @param bits 要置位的事件位
+ * @return 返回时的事件位
+ */
+uint32_t EventGroup_SetBits(EventGroupHandle_t group, uint32_t bits);
+
+#if MYRTOS_USE_DEFERRED_CALL == 1
+/**
+ * @brief 从中断服务例程中置位事件位
+ * @details 事件位先在中断中积攒, 唤醒等待者的工作由延迟调用守护任务完成 (来源编号
+ *          MYRTOS_EVENT_GROUP_DEFER_SOURCE), 守护任务运行之前的多次置位合并为一次。
+ *          置位尚未执行时删除事件组, 积攒的事件位被丢弃, 控制块由延迟调用释放。
+ * @param group 事件组句柄
+ * @param bits 要置位的事件位
+ * @return 0表示成功，-1表示参数无效或延迟调用队列已满
+ */
+int EventGroup_SetBitsFromISR(EventGroupHandle_t group, uint32_t bits);
+#endif
+
+/**
+ * @brief 清除事件位
+ * @param group 事件组句柄
+ * @param bits 要清除的事件位
+ * @return 清除之前的事件位
+ */
+uint32_t EventGroup_ClearBits(EventGroupHandle_t group, uint32_t bits);
+
+/**
+ * @brief 读取当前的事件位
+ * @param group 事件组句柄
+ * @return 当前的事件位
+ */
+uint32_t EventGroup_GetBits(EventGroupHandle_t group);
+
+/**
+ * @brief 等待事件位
+ * @param group 事件组句柄
+ * @param bits_to_wait 等待的事件位
+ * @param options 等待选项，与 Task_WaitSignal 相同: SIGNAL_WAIT_ANY, SIGNAL_WAIT_ALL,
+ *                SIGNAL_CLEAR_ON_EXIT 的组合
+ * @param block_ticks 等待的最大时钟节拍数(0表示不等待)
+ * @return 条件满足时的事件位，超时或事件组被删除返回0
+ */
+uint32_t EventGroup_WaitBits(EventGroupHandle_t group, uint32_t bits_to_wait, uint32_t options,
+                             uint32_t block_ticks);
+
 
 #endif // MYRTOS_H
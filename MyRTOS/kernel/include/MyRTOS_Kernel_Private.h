@@ -23,22 +23,40 @@ typedef struct BlockLink_t {
 
 
 // --- 内核核心对象结构 ---
+/**
+ * @brief 任务链表结构体
+ * @note  同时记录头尾指针, 使尾部插入、任意节点移除和头节点轮转都是 O(1) 操作。
+ *        链表节点通过 TCB 中的 pNextGeneric/pPrevGeneric 串联。
+ */
+typedef struct TaskList_t {
+    TaskHandle_t head; // 链表头节点
+    TaskHandle_t tail; // 链表尾节点
+} TaskList_t;
+
 /**
  * @brief 事件列表结构体
+ * @note  双向链表, 节点通过 TCB 中的 pNextEvent/pPrevEvent 串联。默认按优先级从高到低排列,
+ *        同优先级按到达顺序排队; fifo 置位时完全按到达顺序排队。任意节点的移除都是 O(1) 操作。
  */
 typedef struct EventList_t {
-    volatile TaskHandle_t head; // 事件列表头节点
+    volatile TaskHandle_t head; // 事件列表头节点 (下一个被唤醒的任务)
+    TaskHandle_t tail; // 事件列表尾节点
+    uint8_t fifo; // 等待顺序, 0 为按优先级, 1 为先进先出
 } EventList_t;
 
 /**
  * @brief 互斥锁结构体
  */
 typedef struct Mutex_t {
-    volatile int locked; // 锁状态标记
-    struct Task_t *owner_tcb; // 拥有该互斥锁的任务TCB
+    struct Task_t *volatile owner_tcb; // 拥有该互斥锁的任务TCB, NULL 表示未锁定 (快速路径独占访问的锁字)
     struct Mutex_t *next_held_mutex; // 下一个持有的互斥锁
     EventList_t eventList; // 等待该互斥锁的任务事件列表
     volatile uint32_t recursion_count; // 递归锁定计数
+    uint8_t isStatic; // 控制块由调用者提供, 删除时不释放
+    uint8_t ceiling; // 优先级天花板, 0 表示使用优先级继承协议
+    uint8_t savedPriority; // 持有者获取天花板互斥锁之前的优先级
+    uint8_t exactRestore; // 持有链表中此锁之下只有天花板互斥锁, 按相反顺序释放时可直接恢复 savedPriority
+    uint8_t competitive; // 竞争释放: 释放时只唤醒等待者, 不转交所有权
 } Mutex_t;
 
 /**
@@ -54,28 +72,59 @@ typedef struct Task_t {
     volatile uint32_t notification; // 任务通知值
     volatile uint8_t is_waiting_notification; // 是否正在等待通知
     volatile uint32_t signals_pending; // 已收到但尚未处理的信号位掩码
-    uint32_t signals_wait_mask; // 当前任务正在等待的信号位掩码
-    uint32_t wait_options; // 当前任务的等待选项 (WAIT_ANY, WAIT_ALL, etc.)
+    uint32_t signals_wait_mask; // 当前任务正在等待的信号位掩码 (等待事件组时为事件位掩码)
+    uint32_t wait_options; // 当前任务的等待选项 (WAIT_ANY, WAIT_ALL, etc.), 等待信号和事件组共用
     EventList_t signal_event_list; // 任务自己的、用于等待信号的事件列表
     volatile TaskState_t state; // 任务状态
-    uint32_t taskId; // 任务ID
+    uint32_t taskId; // 任务ID, 同时是任务在槽位表中的下标
+    uint16_t taskGeneration; // 任务所在槽位的代数, 与 taskId 共同组成 TaskRef_t
     StackType_t *stack_base; // 任务栈基地址
     uint8_t priority; // 任务优先级
     uint8_t basePriority; // 任务基础优先级
-    struct Task_t *pNextTask; // 指向下一个任务(就绪链表)
+    uint8_t preemptThreshold; // 抢占阈值, 运行中的任务只会被优先级高于 max(阈值, 当前优先级) 的任务抢占
+    uint32_t timeSlice; // 时间片长度(Tick), 0 表示不参与同优先级轮转
+    uint32_t timeSliceRemaining; // 当前时间片剩余的Tick数
+    uint32_t releaseCount; // Task_DelayUntil 按时释放的次数
+    uint32_t releaseJitterMax; // 最大释放抖动(Tick)
+    uint32_t releaseJitterTotal; // 释放抖动累计(Tick), 与 releaseCount 一起求平均值
+    uint32_t releaseOverruns; // 调用 Task_DelayUntil 时已错过释放点的次数
+    uint32_t inheritBoosts; // 因优先级继承 (包括传递继承) 被提升优先级的次数
+#if MYRTOS_USE_EDF == 1
+    uint64_t absDeadline; // 当前作业的绝对截止时间(Tick), 非EDF任务为 UINT64_MAX
+    uint64_t releaseTime; // 当前作业的释放时间(Tick)
+    uint32_t relativeDeadline; // 相对截止时间(Tick), 0 表示非EDF任务
+    uint32_t period; // 作业周期(Tick)
+    uint32_t deadlineMisses; // 截止时间错过次数
+#endif
+#if MYRTOS_USE_BUDGET == 1
+    uint64_t budgetPeriodEnd; // 当前预算周期的结束时刻(Tick), 到达后预算补满
+    uint32_t budget; // 每个周期的CPU预算(Tick), 0 表示不受预算限制
+    uint32_t budgetPeriod; // 预算周期(Tick)
+    uint32_t budgetUsed; // 当前周期已用的Tick数
+    uint32_t budgetExhaustions; // 因预算用完被挂起的次数
+#endif
+    struct Task_t *pNextTask; // 指向下一个任务(全局任务链表)
+    struct Task_t *pPrevTask; // 指向上一个任务(全局任务链表)
     struct Task_t *pNextGeneric; // 通用链表下一节点指针
     struct Task_t *pPrevGeneric; // 通用链表上一节点指针
+    TaskList_t *pDelayList; // 任务所在的延迟时间轮槽位, 不在延迟链表中时为NULL
     struct Task_t *pNextEvent; // 事件链表下一节点指针
+    struct Task_t *pPrevEvent; // 事件链表上一节点指针
     EventList_t *pEventList; // 任务所属事件列表
     Mutex_t *held_mutexes_head; // 任务持有的互斥锁链表头
+    Mutex_t *blockedOnMutex; // 任务正在等待的互斥锁, 用于沿持有链传递优先级继承
     void *eventData; // 事件相关数据
     const char *taskName; // 任务名称
     uint16_t stackSize_words; // 任务栈大小(字)
+    uint8_t isStatic; // TCB和栈由调用者提供, 删除时不释放, 任务名不复制
 } Task_t;
 
 // TCB中stack_base字段的偏移量
 #define TCB_OFFSET_STACK_BASE offsetof(Task_t, stack_base)
 
+// 任务栈的填充值 (MYRTOS_TASK_STACK_PAINT), 每个字节相同, 以便按字节填充
+#define MYRTOS_STACK_PAINT_VALUE 0xA5A5A5A5UL
+
 /**
  * @brief 队列结构体
  */
@@ -88,6 +137,8 @@ typedef struct Queue_t {
     uint8_t *readPtr; // 读指针
     EventList_t sendEventList; // 发送事件列表
     EventList_t receiveEventList; // 接收事件列表
+    ObjectWatch_t *watchers; // 等待队列写入数据的观察者
+    uint8_t isStatic; // 控制块和存储区由调用者提供, 删除时不释放
 } Queue_t;
 
 /**
@@ -97,22 +148,39 @@ typedef struct Semaphore_t {
     volatile uint32_t count; // 信号量计数
     uint32_t maxCount; // 信号量最大计数
     EventList_t eventList; // 等待该信号量的任务事件列表
+    ObjectWatch_t *watchers; // 等待计数增加的观察者
+    uint8_t isStatic; // 控制块由调用者提供, 删除时不释放
 } Semaphore_t;
 
+/**
+ * @brief 事件组结构体
+ */
+typedef struct EventGroup_t {
+    volatile uint32_t bits; // 当前的事件位
+    volatile uint32_t isrPendingBits; // 中断中置位、尚未由延迟调用处理的事件位
+    EventList_t eventList; // 等待该事件组的任务事件列表
+    uint8_t isStatic; // 控制块由调用者提供, 删除时不释放
+    uint8_t deletePending; // 已删除, 但中断置位的延迟调用尚未执行, 由延迟调用完成释放
+} EventGroup_t;
 
 /*
- * 任务包装器
+ * 静态分配的存储类型 (StaticTask_t 等) 在公开头文件中按相同的成员顺序镜像内部结构体,
+ * 内部结构体改动后必须同步修改, 否则这里会在编译期报错。
  */
-typedef struct {
-    void (*taskFunc)(void *); // 指向真正的用户任务函数
-    void *parameters;         // 指向用户任务的参数
-} TaskEntryPoint_t;
+_Static_assert(sizeof(StaticTask_t) == sizeof(Task_t), "StaticTask_t does not match Task_t.");
+_Static_assert(_Alignof(StaticTask_t) >= _Alignof(Task_t), "StaticTask_t alignment does not match Task_t.");
+_Static_assert(sizeof(StaticQueue_t) == sizeof(Queue_t), "StaticQueue_t does not match Queue_t.");
+_Static_assert(sizeof(StaticMutex_t) == sizeof(Mutex_t), "StaticMutex_t does not match Mutex_t.");
+_Static_assert(sizeof(StaticSemaphore_t) == sizeof(Semaphore_t), "StaticSemaphore_t does not match Semaphore_t.");
+_Static_assert(sizeof(StaticEventGroup_t) == sizeof(EventGroup_t), "StaticEventGroup_t does not match EventGroup_t.");
 
 
 /*===========================================================================*
  *                      内部全局变量声明                                     *
  *===========================================================================*/
 extern TaskHandle_t allTaskListHead; // 所有任务链表头
+#if MYRTOS_USE_HEAP == 1
 extern size_t freeBytesRemaining; // 剩余空闲内存字节数
+#endif
 
 #endif // MYRTOS_KERNEL_PRIVATE_H
@@ -2,6 +2,7 @@
 #define MYRTOS_PORT_H
 
 #include <stdint.h>
+#include "MyRTOS.h"
 
 // 平台无关的数据结构
 typedef uint32_t StackType_t; // CPU栈的自然宽度
@@ -26,6 +27,92 @@ StackType_t *MyRTOS_Port_InitialiseStack(StackType_t *pxTopOfStack, void (*pxCod
  */
 BaseType_t MyRTOS_Port_StartScheduler(void);
 
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+/*
+ * ARMv7-M (Cortex-M3/M4) 的临界区在头文件中内联实现, 内核热路径上不再产生函数调用。
+ * MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY 非0时通过 BASEPRI 只屏蔽优先级数值不小于该值的中断,
+ * 更高优先级的中断在临界区内仍能立即响应; 为0时退回到 PRIMASK 关闭全部中断。
+ */
+#define MYRTOS_PORT_INLINE_CRITICAL 1
+
+#if MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY > 0
+#if MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY >= (1 << __NVIC_PRIO_BITS)
+#error "MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY must be less than (1 << __NVIC_PRIO_BITS)."
+#endif
+// 写入 BASEPRI 的值 (优先级位位于字节的高位)
+#define MYRTOS_PORT_BASEPRI_SYSCALL ((uint32_t) MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - __NVIC_PRIO_BITS))
+#endif
+
+// 临界区嵌套计数, 定义在移植层
+extern volatile UBaseType_t uxCriticalNesting;
+
+/**
+ * @brief 进入临界区。
+ *        屏蔽所有可能调用内核API的中断并增加嵌套计数。
+ */
+static inline void MyRTOS_Port_EnterCritical(void) {
+#if MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY > 0
+    __asm volatile(" msr basepri, %0 \n"
+                   " isb             \n"
+                   " dsb             \n"
+                   :
+                   : "r"(MYRTOS_PORT_BASEPRI_SYSCALL)
+                   : "memory");
+#else
+    __asm volatile(" cpsid i \n" ::: "memory");
+#endif
+    uxCriticalNesting++;
+}
+
+/**
+ * @brief 退出临界区。
+ *        嵌套计数归零时恢复中断。
+ */
+static inline void MyRTOS_Port_ExitCritical(void) {
+    if (uxCriticalNesting > 0) {
+        uxCriticalNesting--;
+        if (uxCriticalNesting == 0) {
+#if MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY > 0
+            __asm volatile(" msr basepri, %0 \n" ::"r"(0UL) : "memory");
+#else
+            __asm volatile(" cpsie i \n" ::: "memory");
+#endif
+        }
+    }
+}
+
+/*
+ * ARMv7-M 的独占访问指令 (LDREX/STREX)。异常进入和返回时硬件会清除本地独占监视器,
+ * 因此 LDREX 与 STREX 之间只要发生过中断或任务切换, STREX 就会失败。
+ * 内核利用这一点在不屏蔽中断的情况下完成无竞争的互斥锁/信号量操作:
+ * 在 LDREX 之后检查等待列表, 等待者只能在一次任务切换之后出现, 而那次切换会使随后的 STREX 失败并重试。
+ */
+#define MYRTOS_PORT_HAS_EXCLUSIVE 1
+
+/**
+ * @brief 独占加载一个字 (LDREX)。
+ */
+static inline uint32_t MyRTOS_Port_LoadExclusive(volatile uint32_t *addr) {
+    uint32_t value;
+    __asm volatile(" ldrex %0, [%1] \n" : "=r"(value) : "r"(addr) : "memory");
+    return value;
+}
+
+/**
+ * @brief 独占存储一个字 (STREX)。
+ * @return 0 存储成功, 1 独占监视器已被清除, 存储未执行。
+ */
+static inline uint32_t MyRTOS_Port_StoreExclusive(volatile uint32_t *addr, uint32_t value) {
+    uint32_t failed;
+    __asm volatile(" strex %0, %2, [%1] \n" : "=&r"(failed) : "r"(addr), "r"(value) : "memory");
+    return failed;
+}
+
+/**
+ * @brief 放弃当前的独占访问 (CLREX)。
+ */
+static inline void MyRTOS_Port_ClearExclusive(void) { __asm volatile(" clrex \n" ::: "memory"); }
+#else
 /**
  * @brief 进入临界区。
  *        必须由平台移植层实现，以保证操作的原子性。
@@ -36,6 +123,7 @@ void MyRTOS_Port_EnterCritical(void);
  * @brief 退出临界区。
  */
 void MyRTOS_Port_ExitCritical(void);
+#endif
 
 /**
  * @brief 在任务上下文中请求一次上下文切换。
@@ -49,4 +137,21 @@ void MyRTOS_Port_Yield(void);
  */
 void MyRTOS_Port_YieldFromISR(BaseType_t higherPriorityTaskWoken);
 
+/**
+ * @brief 停止周期性的系统滴答并进入低功耗休眠 (仅在 MYRTOS_USE_TICKLESS_IDLE == 1 时需要实现)。
+ *        移植层需在关中断后重新确认可休眠的Tick数, 将滴答定时器编程到该时刻,
+ *        醒来后通过 MyRTOS_Tick_Step() 补偿实际经过的完整Tick。
+ * @param expectedIdleTicks 内核在中断开启时估算的可休眠Tick数 (只是提示), 为0时不休眠直接返回,
+ *                          小于 MYRTOS_TICKLESS_MIN_IDLE_TICKS 时只执行一次普通休眠。
+ */
+void MyRTOS_Port_SuppressTicksAndSleep(uint32_t expectedIdleTicks);
+
+/**
+ * @brief 获取一个自由运行、向上计数的32位时间戳 (单位: CPU周期)。
+ *        用于测量短时间间隔 (例如中断延迟调用的等待时间), 两个时间戳相减即为经过的周期数,
+ *        回绕由无符号减法自然处理。
+ * @return 当前时间戳。
+ */
+uint32_t MyRTOS_Port_GetTimestamp(void);
+
 #endif // MYRTOS_PORT_H
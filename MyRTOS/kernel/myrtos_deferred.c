@@ -0,0 +1,245 @@
+/**
+ * @file myrtos_deferred.c
+ * @brief MyRTOS 中断延迟调用模块 (下半部)
+ * @note  中断服务程序通过 MyRTOS_DeferFromISR 把函数和参数投递到一个无锁环形队列,
+ *        由高优先级的内核守护任务按 FIFO 顺序执行。队列操作无锁, 投递路径不修改任何内核链表。
+ */
+
+#include "myrtos_kernel.h"
+
+#if MYRTOS_USE_DEFERRED_CALL == 1
+
+/*===========================================================================*
+ * 私有宏定义
+ *===========================================================================*/
+
+#if (MYRTOS_DEFERRED_QUEUE_LENGTH & (MYRTOS_DEFERRED_QUEUE_LENGTH - 1)) != 0
+#error "MYRTOS_DEFERRED_QUEUE_LENGTH must be a power of two."
+#endif
+
+#define DEFERRED_QUEUE_MASK (MYRTOS_DEFERRED_QUEUE_LENGTH - 1)
+
+/*===========================================================================*
+ * 私有类型定义
+ *===========================================================================*/
+
+/**
+ * @brief 环形队列单元
+ * @note  sequence 采用有界 MPMC 队列 (Vyukov) 的序号协议:
+ *        等于 pos 表示单元空闲可写, 等于 pos + 1 表示已写入可读。
+ */
+typedef struct {
+    volatile uint32_t sequence; // 单元序号
+    DeferredFunc_t func; // 延迟执行的函数
+    void *arg; // 函数参数
+    uint32_t source; // 投递来源编号
+    uint32_t timestamp; // 投递时刻的时间戳
+} DeferredCell_t;
+
+/*===========================================================================*
+ * 私有变量
+ *===========================================================================*/
+
+// 延迟调用环形队列
+static DeferredCell_t deferredQueue[MYRTOS_DEFERRED_QUEUE_LENGTH];
+// 生产者 (中断) 竞争的写位置
+static volatile uint32_t deferredEnqueuePos = 0;
+// 消费者 (守护任务) 独占的读位置
+static uint32_t deferredDequeuePos = 0;
+// 守护任务句柄
+static TaskHandle_t deferredDaemon = NULL;
+// 守护任务因队列为空而阻塞
+static volatile uint8_t deferredDaemonWaiting = 0;
+// 每个来源的统计信息
+static DeferredStats_t deferredStats[MYRTOS_DEFERRED_MAX_SOURCES];
+// 守护任务的TCB和栈
+static StaticTask_t deferredDaemonTcb;
+static StackType_t deferredDaemonStack[MYRTOS_DEFERRED_TASK_STACK];
+
+/*===========================================================================*
+ * 私有函数
+ *===========================================================================*/
+
+/**
+ * @brief 判断队列头部单元是否已写入完成
+ * @note  只由消费者一侧调用。
+ */
+static inline int deferredQueueHeadReady(void) {
+    const DeferredCell_t *cell = &deferredQueue[deferredDequeuePos & DEFERRED_QUEUE_MASK];
+    return __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) == deferredDequeuePos + 1;
+}
+
+/**
+ * @brief 守护任务: 依次取出并执行延迟调用, 队列为空时阻塞
+ */
+static void deferredDaemonTask(void *param) {
+    (void) param;
+    for (;;) {
+        MyRTOS_Port_EnterCritical();
+        if (!deferredQueueHeadReady()) {
+            // 队列为空, 阻塞等待。投递者发现守护任务在等待时会触发调度, 由调度器唤醒
+            removeTaskFromList(get_ready_task_list(currentTask->priority), currentTask);
+            currentTask->state = TASK_STATE_BLOCKED;
+            deferredDaemonWaiting = 1;
+            MyRTOS_Port_ExitCritical();
+            MyRTOS_Port_Yield();
+            continue;
+        }
+        MyRTOS_Port_ExitCritical();
+
+        DeferredCell_t *cell = &deferredQueue[deferredDequeuePos & DEFERRED_QUEUE_MASK];
+        const DeferredFunc_t func = cell->func;
+        void *arg = cell->arg;
+        const uint32_t source = cell->source;
+        const uint32_t postTime = cell->timestamp;
+        // 交还单元给生产者
+        __atomic_store_n(&cell->sequence, deferredDequeuePos + MYRTOS_DEFERRED_QUEUE_LENGTH, __ATOMIC_RELEASE);
+        deferredDequeuePos++;
+
+        const uint32_t startTime = MyRTOS_Port_GetTimestamp();
+        func(arg);
+        const uint32_t endTime = MyRTOS_Port_GetTimestamp();
+
+        // 统计只由守护任务更新, 无需加锁
+        DeferredStats_t *stats = &deferredStats[source];
+        const uint32_t latency = startTime - postTime;
+        const uint32_t runTime = endTime - startTime;
+        stats->executed++;
+        stats->totalLatency += latency;
+        if (latency > stats->maxLatency) {
+            stats->maxLatency = latency;
+        }
+        if (runTime > stats->maxRunTime) {
+            stats->maxRunTime = runTime;
+        }
+    }
+}
+
+/*===========================================================================*
+ * 内部接口实现
+ *===========================================================================*/
+
+/**
+ * @brief 初始化延迟调用队列
+ * @note  由 MyRTOS_Init 调用, 此后中断即可投递, 调度器启动前投递的调用会在守护任务首次运行时执行。
+ */
+void deferred_init(void) {
+    for (uint32_t i = 0; i < MYRTOS_DEFERRED_QUEUE_LENGTH; i++) {
+        deferredQueue[i].sequence = i;
+    }
+    deferredEnqueuePos = 0;
+    deferredDequeuePos = 0;
+    deferredDaemon = NULL;
+    deferredDaemonWaiting = 0;
+    memset(deferredStats, 0, sizeof(deferredStats));
+}
+
+/**
+ * @brief 创建延迟调用守护任务
+ * @note  由 Task_StartScheduler 在创建空闲任务之后调用。
+ * @return 成功返回0，失败返回-1
+ */
+int deferred_daemon_start(void) {
+    deferredDaemon = Task_CreateStatic(deferredDaemonTask, "Deferred", MYRTOS_DEFERRED_TASK_STACK, NULL,
+                                       MYRTOS_DEFERRED_TASK_PRIORITY, deferredDaemonStack, &deferredDaemonTcb);
+    if (deferredDaemon == NULL) {
+        return -1;
+    }
+    // 守护任务执行的都是短小的下半部, 不参与同优先级轮转
+    Task_SetTimeSlice(deferredDaemon, 0);
+    return 0;
+}
+
+/**
+ * @brief 若守护任务正在等待且队列中已有调用, 则唤醒它
+ * @note  由 schedule_next_task 在选择下一个任务之前调用 (即 PendSV 尾部)。
+ *        投递者只负责挂起 PendSV, 真正修改就绪链表的工作在这里完成, 使投递路径无需临界区。
+ */
+void deferred_wake_daemon(void) {
+    if (!deferredDaemonWaiting) {
+        return;
+    }
+    MyRTOS_Port_EnterCritical();
+    if (deferredDaemonWaiting && deferredQueueHeadReady()) {
+        deferredDaemonWaiting = 0;
+        addTaskToReadyList(deferredDaemon);
+    }
+    MyRTOS_Port_ExitCritical();
+}
+
+/*===========================================================================*
+ * 公开接口实现
+ *===========================================================================*/
+
+/**
+ * @brief 从中断中投递一个延迟调用
+ * @note  队列操作无锁, 只在读取时间戳时短暂进入临界区。多个不同优先级的中断可以同时投递,
+ *        执行顺序与占到队列位置的顺序一致。
+ * @param source 投递来源编号, 用于分类统计, 必须小于 MYRTOS_DEFERRED_MAX_SOURCES
+ * @param func 在守护任务上下文中执行的函数
+ * @param arg 函数参数
+ * @return 成功返回0; 队列已满或参数无效返回-1
+ */
+int MyRTOS_DeferFromISR(uint32_t source, DeferredFunc_t func, void *arg) {
+    if (func == NULL || source >= MYRTOS_DEFERRED_MAX_SOURCES) {
+        return -1;
+    }
+    DeferredCell_t *cell;
+    uint32_t pos = __atomic_load_n(&deferredEnqueuePos, __ATOMIC_RELAXED);
+    for (;;) {
+        cell = &deferredQueue[pos & DEFERRED_QUEUE_MASK];
+        const uint32_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        const int32_t diff = (int32_t) (seq - pos);
+        if (diff == 0) {
+            // 单元空闲, 尝试占用该位置 (LDREX/STREX)
+            if (__atomic_compare_exchange_n(&deferredEnqueuePos, &pos, pos + 1, 1, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 队列已满
+            __atomic_fetch_add(&deferredStats[source].dropped, 1, __ATOMIC_RELAXED);
+            return -1;
+        } else {
+            pos = __atomic_load_n(&deferredEnqueuePos, __ATOMIC_RELAXED);
+        }
+    }
+    cell->func = func;
+    cell->arg = arg;
+    cell->source = source;
+    cell->timestamp = MyRTOS_Port_GetTimestamp();
+    __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&deferredStats[source].posted, 1, __ATOMIC_RELAXED);
+    // 守护任务在等待时挂起 PendSV, 由调度器唤醒它
+    if (deferredDaemonWaiting) {
+        MyRTOS_Port_Yield();
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取一个投递来源的统计信息
+ * @param source 投递来源编号
+ * @param stats_out [out] 统计信息
+ * @return 成功返回0，来源编号无效返回-1
+ */
+int MyRTOS_Deferred_GetStats(uint32_t source, DeferredStats_t *stats_out) {
+    if (source >= MYRTOS_DEFERRED_MAX_SOURCES || stats_out == NULL) {
+        return -1;
+    }
+    MyRTOS_Port_EnterCritical();
+    *stats_out = deferredStats[source];
+    MyRTOS_Port_ExitCritical();
+    return 0;
+}
+
+/**
+ * @brief 清零所有来源的统计信息
+ */
+void MyRTOS_Deferred_ResetStats(void) {
+    MyRTOS_Port_EnterCritical();
+    memset(deferredStats, 0, sizeof(deferredStats));
+    MyRTOS_Port_ExitCritical();
+}
+
+#endif /* MYRTOS_USE_DEFERRED_CALL */
@@ -0,0 +1,298 @@
+/**
+ * @file myrtos_eventgroup.c
+ * @brief MyRTOS 事件组模块
+ * @note  事件组是一组共享的标志位, 任意数量的任务可以等待其中的任意位或全部位。
+ *        置位时在一次遍历中唤醒所有条件已满足的等待者, 最多触发一次调度。
+ */
+
+#include "myrtos_kernel.h"
+
+/*===========================================================================*
+ * 外部函数声明
+ *===========================================================================*/
+extern TaskList_t *get_ready_task_list(uint8_t priority);
+
+/*===========================================================================*
+ * 私有函数
+ *===========================================================================*/
+
+/**
+ * @brief 初始化事件组控制块
+ * @param isStatic 非0表示控制块由调用者提供
+ */
+static void eventGroupInit(EventGroup_t *group, uint8_t isStatic) {
+    group->bits = 0;
+    group->isrPendingBits = 0;
+    eventListInit(&group->eventList);
+    group->isStatic = isStatic;
+    group->deletePending = 0;
+}
+
+/**
+ * @brief 判断事件位是否满足等待条件
+ * @param bits 当前事件位
+ * @param mask 等待的事件位
+ * @param options 等待选项
+ */
+static inline int eventGroupSatisfied(uint32_t bits, uint32_t mask, uint32_t options) {
+    if (options & SIGNAL_WAIT_ALL) {
+        return (bits & mask) == mask;
+    }
+    return (bits & mask) != 0;
+}
+
+/**
+ * @brief 唤醒一个等待事件组的任务
+ * @note  必须在临界区中调用。等待者的返回值通过其 eventData 指向的变量传回。
+ *        超时的等待者已被滴答中断放回就绪链表, 但要等它再次运行时才离开事件列表;
+ *        这样的等待者只从事件列表中摘下, 不再加入就绪链表, 也不写入返回值 (它仍按超时返回0)。
+ * @param result 唤醒时交给等待者的事件位, 事件组被删除时为0
+ * @return 被唤醒的任务需要抢占当前任务时返回1
+ */
+static int eventGroupWakeWaiter(Task_t *task, uint32_t result) {
+    if (task->state != TASK_STATE_BLOCKED) {
+        eventListRemove(task);
+        return 0;
+    }
+    *(uint32_t *) task->eventData = result;
+    eventListRemove(task);
+    if (task->delay > 0) {
+        removeTaskFromDelayList(task);
+        task->delay = 0;
+    }
+    addTaskToReadyList(task);
+    return scheduler_task_preempts_current(task);
+}
+
+#if MYRTOS_USE_DEFERRED_CALL == 1
+/**
+ * @brief 延迟调用守护任务中执行中断积攒的置位
+ * @note  事件组在延迟调用执行之前已被删除时, 丢弃积攒的事件位并完成推迟的释放。
+ * @param arg 事件组句柄
+ */
+static void eventGroupDeferredSet(void *arg) {
+    EventGroup_t *group = (EventGroup_t *) arg;
+    MyRTOS_Port_EnterCritical();
+    if (group->deletePending) {
+#if MYRTOS_USE_HEAP == 1
+        if (!group->isStatic) {
+            MyRTOS_Free(group);
+        }
+#endif
+        MyRTOS_Port_ExitCritical();
+        return;
+    }
+    const uint32_t bits = group->isrPendingBits;
+    group->isrPendingBits = 0;
+    MyRTOS_Port_ExitCritical();
+    if (bits != 0) {
+        EventGroup_SetBits(group, bits);
+    }
+}
+#endif
+
+/*===========================================================================*
+ * 公开接口实现
+ *===========================================================================*/
+
+#if MYRTOS_USE_HEAP == 1
+/**
+ * @brief 创建一个事件组, 所有事件位初始为0
+ * @return 成功则返回事件组句柄，失败则返回NULL
+ */
+EventGroupHandle_t EventGroup_Create(void) {
+    EventGroup_t *group = MyRTOS_Malloc(sizeof(EventGroup_t));
+    if (group != NULL) {
+        eventGroupInit(group, 0);
+    }
+    return group;
+}
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块创建一个事件组
+ * @param group_buffer 事件组控制块存储
+ * @return 成功则返回事件组句柄，失败则返回NULL
+ */
+EventGroupHandle_t EventGroup_CreateStatic(StaticEventGroup_t *group_buffer) {
+    if (group_buffer == NULL)
+        return NULL;
+    EventGroup_t *group = (EventGroup_t *) group_buffer;
+    eventGroupInit(group, 1);
+    return group;
+}
+
+/**
+ * @brief 删除一个事件组
+ * @note  所有等待者被唤醒并返回0 (与超时相同)。中断置位的延迟调用仍在队列中时 (isrPendingBits 非0),
+ *        控制块不能立即释放, 只做标记, 由该延迟调用完成释放。
+ * @param group 要删除的事件组句柄
+ */
+void EventGroup_Delete(EventGroupHandle_t group) {
+    if (group == NULL)
+        return;
+    int trigger_yield = 0;
+    MyRTOS_Port_EnterCritical();
+    while (group->eventList.head != NULL) {
+        if (eventGroupWakeWaiter(group->eventList.head, 0))
+            trigger_yield = 1;
+    }
+    if (group->isrPendingBits != 0) {
+        group->deletePending = 1;
+    }
+#if MYRTOS_USE_HEAP == 1
+    else if (!group->isStatic) {
+        MyRTOS_Free(group);
+    }
+#endif
+    MyRTOS_Port_ExitCritical();
+    if (trigger_yield)
+        MyRTOS_Port_Yield();
+}
+
+/**
+ * @brief 置位事件位, 唤醒所有条件因此满足的等待者
+ * @note  等待者在一次遍历中被唤醒, 看到的都是本次置位之后的事件位;
+ *        它们要求退出时清除的位在遍历结束后统一清除, 因此同一次置位可以同时满足多个清除位的等待者。
+ *        遍历期间保持临界区, 临界区长度与等待者数量成正比。
+ * @param group 事件组句柄
+ * @param bits 要置位的事件位
+ * @return 返回时的事件位 (已清除被唤醒的等待者要求清除的位)
+ */
+uint32_t EventGroup_SetBits(EventGroupHandle_t group, uint32_t bits) {
+    if (group == NULL)
+        return 0;
+    int trigger_yield = 0;
+    MyRTOS_Port_EnterCritical();
+    group->bits |= bits;
+    const uint32_t current = group->bits;
+    uint32_t clear_bits = 0;
+    Task_t *task = group->eventList.head;
+    while (task != NULL) {
+        Task_t *next = task->pNextEvent;
+        // 已超时的等待者不参与本次置位, 它要求清除的位也不清除
+        if (task->state == TASK_STATE_BLOCKED &&
+            eventGroupSatisfied(current, task->signals_wait_mask, task->wait_options)) {
+            if (task->wait_options & SIGNAL_CLEAR_ON_EXIT)
+                clear_bits |= task->signals_wait_mask;
+            if (eventGroupWakeWaiter(task, current))
+                trigger_yield = 1;
+        }
+        task = next;
+    }
+    group->bits &= ~clear_bits;
+    const uint32_t result = group->bits;
+    MyRTOS_Port_ExitCritical();
+    if (trigger_yield)
+        MyRTOS_Port_Yield();
+    return result;
+}
+
+#if MYRTOS_USE_DEFERRED_CALL == 1
+/**
+ * @brief 从中断服务程序(ISR)中置位事件位
+ * @note  中断中只把事件位并入 isrPendingBits, 唤醒等待者的遍历推迟到延迟调用守护任务中执行,
+ *        中断内的临界区长度与等待者数量无关。守护任务执行之前多次置位合并为一次延迟调用。
+ *        延迟调用执行之前事件组被删除时, 由该延迟调用释放控制块 (见 EventGroup_Delete)。
+ * @param group 事件组句柄
+ * @param bits 要置位的事件位
+ * @return 成功返回0; 参数无效或延迟调用队列已满返回-1
+ */
+int EventGroup_SetBitsFromISR(EventGroupHandle_t group, uint32_t bits) {
+    if (group == NULL || bits == 0)
+        return -1;
+    int result = 0;
+    MyRTOS_Port_EnterCritical();
+    if (group->deletePending) {
+        result = -1;
+    } else if (group->isrPendingBits == 0 && // 已有未执行的延迟调用时只需并入事件位
+               MyRTOS_DeferFromISR(MYRTOS_EVENT_GROUP_DEFER_SOURCE, eventGroupDeferredSet, group) != 0) {
+        result = -1;
+    } else {
+        group->isrPendingBits |= bits;
+    }
+    MyRTOS_Port_ExitCritical();
+    return result;
+}
+#endif
+
+/**
+ * @brief 清除事件位
+ * @param group 事件组句柄
+ * @param bits 要清除的事件位
+ * @return 清除之前的事件位
+ */
+uint32_t EventGroup_ClearBits(EventGroupHandle_t group, uint32_t bits) {
+    if (group == NULL)
+        return 0;
+    MyRTOS_Port_EnterCritical();
+    const uint32_t previous = group->bits;
+    group->bits &= ~bits;
+    MyRTOS_Port_ExitCritical();
+    return previous;
+}
+
+/**
+ * @brief 读取当前的事件位
+ * @param group 事件组句柄
+ * @return 当前的事件位
+ */
+uint32_t EventGroup_GetBits(EventGroupHandle_t group) {
+    if (group == NULL)
+        return 0;
+    return group->bits;
+}
+
+/**
+ * @brief 等待事件位
+ * @param group 事件组句柄
+ * @param bits_to_wait 等待的事件位
+ * @param options 等待选项, SIGNAL_WAIT_ANY/SIGNAL_WAIT_ALL 与 SIGNAL_CLEAR_ON_EXIT 的组合
+ * @param block_ticks 条件不满足时阻塞等待的最大滴答数。0表示不等待，MYRTOS_MAX_DELAY表示永久等待。
+ * @return 条件满足时的事件位 (清除之前)，超时或事件组被删除返回0
+ */
+uint32_t EventGroup_WaitBits(EventGroupHandle_t group, uint32_t bits_to_wait, uint32_t options,
+                             uint32_t block_ticks) {
+    if (group == NULL || bits_to_wait == 0)
+        return 0;
+    uint32_t result = 0;
+    MyRTOS_Port_EnterCritical();
+    // 情况1: 条件已满足，直接返回
+    if (eventGroupSatisfied(group->bits, bits_to_wait, options)) {
+        result = group->bits;
+        if (options & SIGNAL_CLEAR_ON_EXIT)
+            group->bits &= ~bits_to_wait;
+        MyRTOS_Port_ExitCritical();
+        return result;
+    }
+    // 情况2: 条件不满足，且不阻塞
+    if (block_ticks == 0) {
+        MyRTOS_Port_ExitCritical();
+        return 0;
+    }
+    // 情况3: 阻塞等待, 置位者通过 eventData 写入唤醒时的事件位
+    currentTask->signals_wait_mask = bits_to_wait;
+    currentTask->wait_options = options;
+    currentTask->eventData = &result;
+    removeTaskFromList(get_ready_task_list(currentTask->priority), currentTask);
+    currentTask->state = TASK_STATE_BLOCKED;
+    eventListInsert(&group->eventList, currentTask);
+    currentTask->delay = 0;
+    if (block_ticks != MYRTOS_MAX_DELAY) {
+        currentTask->delay = MyRTOS_GetTick() + block_ticks;
+        addTaskToDelayList(currentTask);
+    }
+    MyRTOS_Port_ExitCritical();
+    MyRTOS_Port_Yield(); // 触发调度，进入阻塞
+
+    MyRTOS_Port_EnterCritical();
+    // 仍在事件列表中说明是超时唤醒 (超时后已被置位或删除操作摘下时, result 同样保持为0)
+    if (currentTask->pEventList != NULL) {
+        eventListRemove(currentTask);
+    }
+    currentTask->eventData = NULL;
+    currentTask->signals_wait_mask = 0;
+    currentTask->wait_options = 0;
+    MyRTOS_Port_ExitCritical();
+    return result;
+}
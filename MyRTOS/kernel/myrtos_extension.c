@@ -1,6 +1,8 @@
 /**
  * @file myrtos_extension.c
  * @brief MyRTOS 内核扩展机制模块
+ * @note  每个扩展在注册时声明订阅的事件掩码, 广播时只调用订阅了该事件的扩展。
+ *        编译期静态钩子 (MYRTOS_EXTENSION_STATIC_HOOK) 被直接调用, 不经过注册表。
  */
 
 #include "myrtos_kernel.h"
@@ -9,25 +11,60 @@
  * 私有变量
  *===========================================================================*/
 
+#if MAX_KERNEL_EXTENSIONS > 0
 // 内核扩展回调函数数组
 static KernelExtensionCallback_t g_extensions[MAX_KERNEL_EXTENSIONS] = {NULL};
+// 每个内核扩展订阅的事件掩码, 与 g_extensions 一一对应
+static uint32_t g_extension_masks[MAX_KERNEL_EXTENSIONS] = {0};
 // 已注册的内核扩展数量
 static uint8_t g_extension_count = 0;
+// 所有已注册扩展订阅掩码的并集, 供广播点快速判断
+volatile uint32_t g_extension_event_mask = 0;
+
+/*===========================================================================*
+ * 私有函数
+ *===========================================================================*/
+
+/**
+ * @brief 重新计算订阅掩码的并集
+ * @note  必须在临界区内调用。
+ */
+static void extension_update_event_mask(void) {
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < g_extension_count; ++i) {
+        mask |= g_extension_masks[i];
+    }
+    g_extension_event_mask = mask;
+}
+#endif
 
 /*===========================================================================*
  * 内部函数实现
  *===========================================================================*/
 
 /**
- * @brief 向所有已注册的内核扩展广播一个事件
+ * @brief 向订阅了该事件的内核扩展广播一个事件
  * @param pEventData 要广播的事件数据
  */
 void broadcast_event(const KernelEventData_t *pEventData) {
+    const uint32_t bit = KERNEL_EVENT_MASK(pEventData->eventType);
+#if MYRTOS_EXTENSION_STATIC_EVENTS != 0
+    if (MYRTOS_EXTENSION_STATIC_EVENTS & bit) {
+        MYRTOS_EXTENSION_STATIC_HOOK(pEventData);
+    }
+#endif
+#if MAX_KERNEL_EXTENSIONS > 0
+    if ((g_extension_event_mask & bit) == 0) {
+        return;
+    }
     for (uint8_t i = 0; i < g_extension_count; ++i) {
-        if (g_extensions[i]) {
+        if (g_extension_masks[i] & bit) {
             g_extensions[i](pEventData);
         }
     }
+#else
+    (void) bit;
+#endif
 }
 
 /*===========================================================================*
@@ -36,28 +73,44 @@ void broadcast_event(const KernelEventData_t *pEventData) {
 
 /**
  * @brief 注册一个内核扩展回调函数
- * @note  内核扩展可用于调试、跟踪或实现自定义功能，它会在特定内核事件发生时被调用。
+ * @note  内核扩展可用于调试、跟踪或实现自定义功能，它会在订阅的内核事件发生时被调用。
+ *        重复注册同一个回调会替换它的订阅掩码。
  * @param callback 要注册的回调函数指针
+ * @param event_mask 订阅的事件掩码
  * @return 成功返回0，失败返回-1
  */
-int MyRTOS_RegisterExtension(KernelExtensionCallback_t callback) {
-    MyRTOS_Port_EnterCritical();
-    // 检查扩展槽是否已满或回调函数是否为空
-    if (g_extension_count >= MAX_KERNEL_EXTENSIONS || callback == NULL) {
-        MyRTOS_Port_ExitCritical();
+int MyRTOS_RegisterExtension(KernelExtensionCallback_t callback, uint32_t event_mask) {
+#if MAX_KERNEL_EXTENSIONS > 0
+    if (callback == NULL) {
         return -1;
     }
-    // 避免重复注册
+    MyRTOS_Port_EnterCritical();
+    // 已注册的回调只更新订阅掩码
     for (uint8_t i = 0; i < g_extension_count; ++i) {
         if (g_extensions[i] == callback) {
+            g_extension_masks[i] = event_mask;
+            extension_update_event_mask();
             MyRTOS_Port_ExitCritical();
             return 0;
         }
     }
+    // 检查扩展槽是否已满
+    if (g_extension_count >= MAX_KERNEL_EXTENSIONS) {
+        MyRTOS_Port_ExitCritical();
+        return -1;
+    }
     // 添加新的回调
-    g_extensions[g_extension_count++] = callback;
+    g_extensions[g_extension_count] = callback;
+    g_extension_masks[g_extension_count] = event_mask;
+    g_extension_count++;
+    extension_update_event_mask();
     MyRTOS_Port_ExitCritical();
     return 0;
+#else
+    (void) callback;
+    (void) event_mask;
+    return -1;
+#endif
 }
 
 /**
@@ -66,22 +119,29 @@ int MyRTOS_RegisterExtension(KernelExtensionCallback_t callback) {
  * @return 成功返回0，失败（未找到该回调）返回-1
  */
 int MyRTOS_UnregisterExtension(KernelExtensionCallback_t callback) {
+#if MAX_KERNEL_EXTENSIONS > 0
     int found = 0;
-    MyRTOS_Port_EnterCritical();
     if (callback == NULL) {
-        MyRTOS_Port_ExitCritical();
         return -1;
     }
+    MyRTOS_Port_EnterCritical();
     for (uint8_t i = 0; i < g_extension_count; ++i) {
         if (g_extensions[i] == callback) {
             // 将最后一个元素移到当前位置，然后缩减计数
             g_extensions[i] = g_extensions[g_extension_count - 1];
+            g_extension_masks[i] = g_extension_masks[g_extension_count - 1];
             g_extensions[g_extension_count - 1] = NULL;
+            g_extension_masks[g_extension_count - 1] = 0;
             g_extension_count--;
+            extension_update_event_mask();
             found = 1;
             break;
         }
     }
     MyRTOS_Port_ExitCritical();
     return found ? 0 : -1;
+#else
+    (void) callback;
+    return -1;
+#endif
 }
@@ -20,11 +20,21 @@ volatile uint8_t g_scheduler_started = 0;
 volatile uint32_t criticalNestingCount = 0;
 // 所有已创建任务的链表头
 TaskHandle_t allTaskListHead = NULL;
+// 所有已创建任务的链表尾, 使新任务 O(1) 追加到链表末尾
+TaskHandle_t allTaskListTail = NULL;
 // 当前正在运行的任务的句柄
 TaskHandle_t currentTask = NULL;
 // 空闲任务的句柄
 TaskHandle_t idleTask = NULL;
 
+/*===========================================================================*
+ * 私有变量
+ *===========================================================================*/
+
+// 空闲任务的TCB和栈, 静态分配使调度器启动不依赖内存堆
+static StaticTask_t idleTaskTcb;
+static StackType_t idleTaskStack[MYRTOS_IDLE_TASK_STACK];
+
 /*===========================================================================*
  * 公开接口实现
  *===========================================================================*/
@@ -36,9 +46,14 @@ TaskHandle_t idleTask = NULL;
  */
 void MyRTOS_Init(void) {
     allTaskListHead = NULL;
+    allTaskListTail = NULL;
     currentTask = NULL;
     idleTask = NULL;
+    task_slots_init();
     scheduler_init();
+#if MYRTOS_USE_DEFERRED_CALL == 1
+    deferred_init();
+#endif
 }
 
 /**
@@ -53,11 +68,18 @@ void Task_StartScheduler(void (*idle_task_func)(void *)) {
         while (1);
     }
     // 创建空闲任务，其优先级为最低
-    idleTask = Task_Create(idle_task_func, "IDLE", 128, NULL, 0);
+    idleTask = Task_CreateStatic(idle_task_func, "IDLE", MYRTOS_IDLE_TASK_STACK, NULL, 0, idleTaskStack,
+                                 &idleTaskTcb);
     if (idleTask == NULL) {
         // 如果空闲任务创建失败，系统无法继续
         while (1);
     }
+#if MYRTOS_USE_DEFERRED_CALL == 1
+    // 创建中断延迟调用的守护任务
+    if (deferred_daemon_start() != 0) {
+        while (1);
+    }
+#endif
     // 标记调度器已启动
     g_scheduler_started = 1;
     // 手动调用一次调度以选择第一个要运行的任务
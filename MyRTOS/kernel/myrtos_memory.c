@@ -5,6 +5,8 @@
 
 #include "myrtos_kernel.h"
 
+#if MYRTOS_USE_HEAP == 1
+
 /*===========================================================================*
  * 私有变量
  *===========================================================================*/
@@ -105,7 +107,8 @@ static void insertBlockIntoFreeList(BlockLink_t *blockToInsert) {
 static void *rtos_malloc(const size_t wantedSize) {
     BlockLink_t *block, *previousBlock, *newBlockLink;
     void *pvReturn = NULL;
-    MyRTOS_Port_EnterCritical(); {
+    // 内存堆只在任务上下文中使用, 锁定调度器即可, 首次适配的遍历不再关中断
+    MyRTOS_Schedule_Lock(); {
         // 如果堆尚未初始化，则进行初始化
         if (blockLinkEnd == NULL) {
             heapInit();
@@ -147,7 +150,7 @@ static void *rtos_malloc(const size_t wantedSize) {
             MyRTOS_ReportError(KERNEL_ERROR_MALLOC_FAILED, (void *) wantedSize);
         }
     }
-    MyRTOS_Port_ExitCritical();
+    MyRTOS_Schedule_Unlock();
     return pvReturn;
 }
 
@@ -168,11 +171,11 @@ static void rtos_free(void *pv) {
     if (((link->blockSize & blockAllocatedBit) != 0) && (link->nextFreeBlock == NULL)) {
         // 清除已分配标志
         link->blockSize &= ~blockAllocatedBit;
-        MyRTOS_Port_EnterCritical();
+        MyRTOS_Schedule_Lock();
         // 更新剩余空闲字节数并将其插回空闲链表
         freeBytesRemaining += link->blockSize;
         insertBlockIntoFreeList(link);
-        MyRTOS_Port_ExitCritical();
+        MyRTOS_Schedule_Unlock();
     }
 }
 
@@ -189,8 +192,10 @@ static void rtos_free(void *pv) {
 void *MyRTOS_Malloc(size_t wantedSize) {
     void *pv = rtos_malloc(wantedSize);
     // 广播内存分配事件
-    KernelEventData_t eventData = {.eventType = KERNEL_EVENT_MALLOC, .mem = {.ptr = pv, .size = wantedSize}};
-    broadcast_event(&eventData);
+    if (extension_event_wanted(KERNEL_EVENT_MALLOC)) {
+        KernelEventData_t eventData = {.eventType = KERNEL_EVENT_MALLOC, .mem = {.ptr = pv, .size = wantedSize}};
+        broadcast_event(&eventData);
+    }
     return pv;
 }
 
@@ -200,7 +205,7 @@ void *MyRTOS_Malloc(size_t wantedSize) {
  * @param pv 要释放的内存指针，必须是通过 `MyRTOS_Malloc` 分配的
  */
 void MyRTOS_Free(void *pv) {
-    if (pv) {
+    if (pv && extension_event_wanted(KERNEL_EVENT_FREE)) {
         // 在释放前获取块大小以用于事件广播
         BlockLink_t *link = (BlockLink_t *) ((uint8_t *) pv - heapStructSize);
         KernelEventData_t eventData = {
@@ -211,3 +216,5 @@ void MyRTOS_Free(void *pv) {
     }
     rtos_free(pv);
 }
+
+#endif /* MYRTOS_USE_HEAP */
@@ -9,13 +9,167 @@
  * 外部函数声明
  *===========================================================================*/
 extern void task_set_priority(TaskHandle_t task, uint8_t newPriority);
-extern TaskHandle_t *get_delayed_task_list_head(void);
-extern TaskHandle_t *get_ready_task_list(uint8_t priority);
+extern TaskList_t *get_ready_task_list(uint8_t priority);
+
+/*===========================================================================*
+ * 私有变量
+ *===========================================================================*/
+
+// 互斥锁统计, 只在临界区中修改
+static MutexStats_t g_mutexStats;
+
+/*===========================================================================*
+ * 私有函数
+ *===========================================================================*/
+
+/**
+ * @brief 计算任务应有的优先级: 基础优先级与其持有的所有互斥锁上最高等待者优先级中的较大者
+ * @note  必须在临界区中调用。等待者的优先级本身已包含它继承来的优先级, 因此结果是传递的。
+ */
+static uint8_t mutexInheritedPriority(const Task_t *task) {
+    uint8_t priority = task->basePriority;
+    for (Mutex_t *held = task->held_mutexes_head; held != NULL; held = held->next_held_mutex) {
+        if (held->ceiling > priority)
+            priority = held->ceiling;
+        priority = eventListHighestPriority(&held->eventList, priority);
+    }
+    return priority;
+}
+
+/**
+ * @brief 任务获得天花板互斥锁后, 记录原优先级并提升到天花板
+ * @note  必须在临界区中、锁已挂入任务的持有链表之后调用。
+ *        下方的锁都是可以直接恢复的天花板互斥锁时, 记录的原优先级是精确的, 释放时无需重新计算。
+ * @param mutex 天花板互斥锁
+ * @param task 新的持有者 (正在运行, 或刚被移出等待队列)
+ */
+static void mutexCeilingAcquire(Mutex_t *mutex, Task_t *task) {
+    const Mutex_t *below = mutex->next_held_mutex;
+    mutex->savedPriority = task->priority;
+    mutex->exactRestore = (below == NULL) || (below->ceiling != 0 && below->exactRestore);
+    if (mutex->ceiling > task->priority) {
+        if (task == currentTask)
+            task_set_running_priority(task, mutex->ceiling);
+        else
+            task_set_priority(task, mutex->ceiling);
+    }
+}
+
+/**
+ * @brief 重新计算持有者的优先级, 并沿 "等待互斥锁 -> 该锁的持有者" 链继续传递
+ * @note  必须在临界区中调用。提升 (有新的等待者) 和回落 (等待者超时、被删除或挂起) 都使用这段代码:
+ *        每一级都按自己持有的锁重新计算, 优先级不变的一级即为链的终点。
+ *        持有者自己也在等待时, task_set_priority 会让它在等待队列中重新排队, 从而影响下一级。
+ *        每一级经过的锁上最高等待者的优先级同时作为下限: 快速路径在 STREX 之后才把锁挂入持有链表
+ *        (释放时在 STREX 之前摘下), 持有者在这段窗口内被抢占时, 持有链表中还找不到这把锁。
+ *        遍历深度受 MYRTOS_MUTEX_INHERIT_DEPTH 限制, 使临界区的长度有界 (锁之间的环形等待也能终止)。
+ * @param owner 链上的第一个持有者, 可为NULL
+ * @param via 链上第一个持有者被等待的锁 (即 owner 持有的锁), 不经过锁时为NULL
+ */
+static void mutexPropagatePriority(Task_t *owner, const Mutex_t *via) {
+    uint32_t depth = 0;
+    while (owner != NULL) {
+        uint8_t newPriority = mutexInheritedPriority(owner);
+        if (via != NULL)
+            newPriority = eventListHighestPriority(&via->eventList, newPriority);
+        if (newPriority == owner->priority)
+            break;
+        if (depth == MYRTOS_MUTEX_INHERIT_DEPTH) {
+            g_mutexStats.depthLimitHits++;
+            break;
+        }
+        depth++;
+        if (newPriority > owner->priority) {
+            owner->inheritBoosts++;
+            g_mutexStats.boosts++;
+            if (depth > 1)
+                g_mutexStats.transitiveBoosts++;
+            if (depth > g_mutexStats.maxDepth)
+                g_mutexStats.maxDepth = depth;
+        }
+        task_set_priority(owner, newPriority);
+        via = owner->blockedOnMutex;
+        owner = (via != NULL) ? via->owner_tcb : NULL;
+    }
+}
+
+/**
+ * @brief 初始化互斥锁控制块
+ * @param isStatic 非0表示控制块由调用者提供
+ * @param ceiling 优先级天花板, 0 表示使用优先级继承协议
+ */
+static void mutexInit(Mutex_t *mutex, uint8_t isStatic, uint8_t ceiling) {
+    mutex->owner_tcb = NULL;
+    mutex->next_held_mutex = NULL;
+    mutex->recursion_count = 0;
+    eventListInit(&mutex->eventList);
+    mutex->isStatic = isStatic;
+    mutex->ceiling = ceiling;
+    mutex->savedPriority = 0;
+    mutex->exactRestore = 0;
+    mutex->competitive = 0;
+}
+
+#if SYNC_FAST_PATH == 1
+/**
+ * @brief 快速路径: 用独占访问指令获取未被占用的互斥锁, 不进入临界区
+ * @note  持有链表只由持有者自己修改 (或在持有者阻塞时由释放者修改), 因此获取之后再挂入链表不需要临界区。
+ *        获取与挂入之间被抢占时, 阻塞的等待者以这把锁为下限提升持有者 (见 mutexPropagatePriority);
+ *        挂入之后若已有等待者, 再按完整的持有链表重新计算一次, 纠正窗口内其他锁上的回落。
+ * @return 成功获取返回1, 锁已被占用返回0 (交给临界区路径处理)
+ */
+static inline int mutexTryLockFast(Mutex_t *mutex) {
+    volatile uint32_t *lockWord = (volatile uint32_t *) &mutex->owner_tcb;
+    do {
+        // 竞争释放的锁空闲时仍可能有等待者, 获取后要继承它们的优先级, 交给临界区路径处理
+        if (MyRTOS_Port_LoadExclusive(lockWord) != 0 || (mutex->competitive && mutex->eventList.head != NULL)) {
+            MyRTOS_Port_ClearExclusive();
+            return 0;
+        }
+    } while (MyRTOS_Port_StoreExclusive(lockWord, (uint32_t) (uintptr_t) currentTask) != 0);
+    mutex->next_held_mutex = currentTask->held_mutexes_head;
+    currentTask->held_mutexes_head = mutex;
+    if (mutex->eventList.head != NULL) {
+        MyRTOS_Port_EnterCritical();
+        mutexPropagatePriority(currentTask, NULL);
+        MyRTOS_Port_ExitCritical();
+    }
+    return 1;
+}
+
+/**
+ * @brief 快速路径: 释放没有等待者的互斥锁, 不进入临界区
+ * @note  只处理最常见的情况: 释放的是最近获取的锁, 且当前没有继承来的优先级需要恢复。
+ *        锁在释放前先从持有链表中摘下, 因为一旦释放, 新的持有者会立即改写 next_held_mutex。
+ *        等待者只能在一次任务切换之后出现, 而切换会清除独占监视器使 STREX 失败, 重试时即可看到等待者。
+ * @return 成功释放返回1, 需要临界区路径处理返回0 (此时锁和持有链表保持原样)
+ */
+static inline int mutexTryUnlockFast(Mutex_t *mutex) {
+    Task_t *self = currentTask;
+    if (mutex->owner_tcb != self || self->held_mutexes_head != mutex || self->priority != self->basePriority)
+        return 0;
+    volatile uint32_t *lockWord = (volatile uint32_t *) &mutex->owner_tcb;
+    Mutex_t *next = mutex->next_held_mutex;
+    self->held_mutexes_head = next;
+    mutex->next_held_mutex = NULL;
+    do {
+        (void) MyRTOS_Port_LoadExclusive(lockWord);
+        if (mutex->eventList.head != NULL) {
+            MyRTOS_Port_ClearExclusive();
+            mutex->next_held_mutex = next;
+            self->held_mutexes_head = mutex;
+            return 0;
+        }
+    } while (MyRTOS_Port_StoreExclusive(lockWord, 0) != 0);
+    return 1;
+}
+#endif
 
 /*===========================================================================*
  * 公开接口实现
  *===========================================================================*/
 
+#if MYRTOS_USE_HEAP == 1
 /**
  * @brief 创建一个互斥锁
  * @return 成功则返回互斥锁句柄，失败则返回NULL
@@ -23,14 +177,55 @@ extern TaskHandle_t *get_ready_task_list(uint8_t priority);
 MutexHandle_t Mutex_Create(void) {
     Mutex_t *mutex = MyRTOS_Malloc(sizeof(Mutex_t));
     if (mutex != NULL) {
-        mutex->locked = 0;
-        mutex->owner_tcb = NULL;
-        mutex->next_held_mutex = NULL;
-        mutex->recursion_count = 0;
-        eventListInit(&mutex->eventList);
+        mutexInit(mutex, 0, 0);
+    }
+    return mutex;
+}
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块创建一个互斥锁
+ * @param mutex_buffer 互斥锁控制块存储
+ * @return 成功则返回互斥锁句柄，失败则返回NULL
+ */
+MutexHandle_t Mutex_CreateStatic(StaticMutex_t *mutex_buffer) {
+    if (mutex_buffer == NULL)
+        return NULL;
+    Mutex_t *mutex = (Mutex_t *) mutex_buffer;
+    mutexInit(mutex, 1, 0);
+    return mutex;
+}
+
+#if MYRTOS_USE_HEAP == 1
+/**
+ * @brief 创建一个优先级天花板互斥锁
+ * @param ceiling 优先级天花板
+ * @return 成功则返回互斥锁句柄，天花板无效或内存不足返回NULL
+ */
+MutexHandle_t Mutex_CreateCeiling(uint8_t ceiling) {
+    if (ceiling == 0 || PRIORITY_OUT_OF_RANGE(ceiling))
+        return NULL;
+    Mutex_t *mutex = MyRTOS_Malloc(sizeof(Mutex_t));
+    if (mutex != NULL) {
+        mutexInit(mutex, 0, ceiling);
     }
     return mutex;
 }
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块创建一个优先级天花板互斥锁
+ * @param mutex_buffer 互斥锁控制块存储
+ * @param ceiling 优先级天花板
+ * @return 成功则返回互斥锁句柄，参数无效返回NULL
+ */
+MutexHandle_t Mutex_CreateCeilingStatic(StaticMutex_t *mutex_buffer, uint8_t ceiling) {
+    if (mutex_buffer == NULL || ceiling == 0 || PRIORITY_OUT_OF_RANGE(ceiling))
+        return NULL;
+    Mutex_t *mutex = (Mutex_t *) mutex_buffer;
+    mutexInit(mutex, 1, ceiling);
+    return mutex;
+}
 
 /**
  * @brief 删除一个互斥锁
@@ -52,9 +247,10 @@ void Mutex_Delete(MutexHandle_t mutex) {
             Task_t *taskToWake = mutex->eventList.head;
             // 从事件列表中移除任务。eventListRemove 会处理好 taskToWake->pEventList 的清理
             eventListRemove(taskToWake);
+            taskToWake->blockedOnMutex = NULL;
             // 如果任务因为超时也存在于延迟列表中，则一并移除
             if (taskToWake->delay > 0) {
-                removeTaskFromList(get_delayed_task_list_head(), taskToWake);
+                removeTaskFromDelayList(taskToWake);
                 taskToWake->delay = 0;
             }
             // 将被唤醒的任务重新添加到就绪列表中
@@ -80,16 +276,57 @@ void Mutex_Delete(MutexHandle_t mutex) {
                     p_iterator->next_held_mutex = mutex->next_held_mutex;
                 }
             }
+            // 被唤醒的等待者不再提升持有者，沿链重新计算
+            mutexPropagatePriority(owner_tcb, NULL);
         }
 
         // 释放互斥锁结构本身占用的内存
         // 此时，已经没有任何任务的TCB或事件列表引用这个互斥锁了，可以安全释放
-        MyRTOS_Free(mutex);
+#if MYRTOS_USE_HEAP == 1
+        if (!mutex->isStatic) {
+            MyRTOS_Free(mutex);
+        }
+#endif
     }
     MyRTOS_Port_ExitCritical();
     // 被唤醒的任务会在下一次调度点（如时钟滴答）运行时获得CPU。
 }
 
+/**
+ * @brief 设置互斥锁等待队列的排队顺序
+ * @note  先进先出顺序下, 释放时交给等待最久的任务, 优先级继承仍按所有等待者中的最高优先级计算。
+ * @param mutex 互斥锁句柄
+ * @param order 排队顺序
+ * @return 成功返回0，句柄无效或已有任务在等待返回-1
+ */
+int Mutex_SetWaitOrder(MutexHandle_t mutex, WaitOrder_t order) {
+    if (mutex == NULL)
+        return -1;
+    int result = -1;
+    MyRTOS_Port_EnterCritical();
+    if (mutex->eventList.head == NULL) {
+        eventListSetFifo(&mutex->eventList, order == WAIT_ORDER_FIFO);
+        result = 0;
+    }
+    MyRTOS_Port_ExitCritical();
+    return result;
+}
+
+/**
+ * @brief 设置互斥锁的释放方式
+ * @param mutex 互斥锁句柄
+ * @param mode 释放方式
+ * @return 成功返回0，参数无效返回-1
+ */
+int Mutex_SetReleaseMode(MutexHandle_t mutex, MutexReleaseMode_t mode) {
+    if (mutex == NULL || (mode != MUTEX_RELEASE_HANDOFF && mode != MUTEX_RELEASE_COMPETITIVE))
+        return -1;
+    MyRTOS_Port_EnterCritical();
+    mutex->competitive = (mode == MUTEX_RELEASE_COMPETITIVE);
+    MyRTOS_Port_ExitCritical();
+    return 0;
+}
+
 /**
  * @brief 尝试获取一个互斥锁，带超时
  * @param mutex 目标互斥锁句柄
@@ -97,50 +334,84 @@ void Mutex_Delete(MutexHandle_t mutex) {
  * @return 成功获取返回1，失败或超时返回0
  */
 int Mutex_Lock_Timeout(MutexHandle_t mutex, uint32_t block_ticks) {
+#if SYNC_FAST_PATH == 1
+    // 天花板互斥锁获取时要修改就绪链表, 总是进入临界区
+    if (mutex->ceiling == 0 && mutexTryLockFast(mutex))
+        return 1;
+#endif
+    // 基础优先级高于天花板的任务使用天花板互斥锁会破坏协议, 直接拒绝
+    if (mutex->ceiling != 0 && currentTask->basePriority > mutex->ceiling) {
+        MyRTOS_Port_EnterCritical();
+        g_mutexStats.ceilingViolations++;
+        MyRTOS_Port_ExitCritical();
+        return 0;
+    }
+    uint64_t deadline = 0; // 首次阻塞时确定的超时时刻, 重新等待时沿用
+    int competitiveWake = 0; // 是否刚被竞争释放唤醒 (而非挂起恢复、锁被删除等原因)
     while (1) {
         MyRTOS_Port_EnterCritical();
         // 情况1: 锁未被占用，成功获取
-        if (!mutex->locked) {
-            mutex->locked = 1;
+        if (mutex->owner_tcb == NULL) {
             mutex->owner_tcb = currentTask;
             // 将此互斥锁加入当前任务持有的互斥锁链表中
             mutex->next_held_mutex = currentTask->held_mutexes_head;
             currentTask->held_mutexes_head = mutex;
+            if (mutex->ceiling != 0)
+                mutexCeilingAcquire(mutex, currentTask);
+            // 竞争释放后抢先获取了锁, 继承仍在等待的任务的优先级
+            if (mutex->eventList.head != NULL)
+                mutexPropagatePriority(currentTask, NULL);
             MyRTOS_Port_ExitCritical();
             return 1;
         }
-        // 情况2: 锁已被占用，且不允许阻塞
-        if (block_ticks == 0) {
+        // 竞争释放唤醒了当前任务, 但锁在它运行之前已被其他任务重新获取
+        if (competitiveWake)
+            g_mutexStats.convoysAvoided++;
+        competitiveWake = 0;
+        // 情况2: 锁已被占用，且不允许阻塞 (或重新等待时已经超时)
+        if (block_ticks == 0 || (deadline != 0 && MyRTOS_GetTick() >= deadline)) {
             MyRTOS_Port_ExitCritical();
             return 0;
         }
         // 情况3: 锁已被占用，需要阻塞
-        // 实现优先级继承：如果当前任务优先级高于锁的持有者，则提升持有者的优先级
-        TaskHandle_t owner_tcb = mutex->owner_tcb;
-        if (owner_tcb != NULL && currentTask->priority > owner_tcb->priority) {
-            task_set_priority(owner_tcb, currentTask->priority);
-        }
         // 将当前任务从就绪列表移除，并加入互斥锁的等待列表
         removeTaskFromList(get_ready_task_list(currentTask->priority), currentTask);
         currentTask->state = TASK_STATE_BLOCKED;
         eventListInsert(&mutex->eventList, currentTask);
+        currentTask->blockedOnMutex = mutex;
+        // 实现优先级继承：提升持有者的优先级，持有者也在等待其他锁时沿链继续传递
+        mutexPropagatePriority(mutex->owner_tcb, mutex);
         currentTask->delay = 0;
         if (block_ticks != MYRTOS_MAX_DELAY) {
-            currentTask->delay = MyRTOS_GetTick() + block_ticks;
-            addTaskToSortedDelayList(currentTask);
+            if (deadline == 0)
+                deadline = MyRTOS_GetTick() + block_ticks;
+            currentTask->delay = deadline;
+            addTaskToDelayList(currentTask);
         }
         MyRTOS_Port_ExitCritical();
         MyRTOS_Port_Yield(); // 触发调度，进入阻塞
-        // 任务被唤醒后
+        // 任务被唤醒后。释放者只在竞争释放时把 eventData 指向这把锁, 此后到当前任务运行之前不会再被改写
+        competitiveWake = (currentTask->eventData == mutex);
+        currentTask->eventData = NULL;
         if (mutex->owner_tcb == currentTask)
             return 1; // 检查是否已成为新的持有者
         // 如果是超时唤醒
         if (currentTask->pEventList != NULL) {
             MyRTOS_Port_EnterCritical();
+            // 超时唤醒后、进入临界区之前锁可能已经交给了当前任务
+            if (mutex->owner_tcb == currentTask) {
+                MyRTOS_Port_ExitCritical();
+                return 1;
+            }
             eventListRemove(currentTask);
+            currentTask->blockedOnMutex = NULL;
+            // 超时的等待者不再提升持有者，沿链重新计算
+            mutexPropagatePriority(mutex->owner_tcb, mutex);
             MyRTOS_Port_ExitCritical();
             return 0;
         }
+        // 竞争释放唤醒、锁被删除或任务被挂起后恢复，重新尝试获取
+        currentTask->blockedOnMutex = NULL;
     }
 }
 
@@ -155,48 +426,77 @@ void Mutex_Lock(MutexHandle_t mutex) { Mutex_Lock_Timeout(mutex, MYRTOS_MAX_DELA
  * @param mutex 目标互斥锁句柄
  */
 void Mutex_Unlock(MutexHandle_t mutex) {
+#if SYNC_FAST_PATH == 1
+    if (mutexTryUnlockFast(mutex))
+        return;
+#endif
     int trigger_yield = 0;
     MyRTOS_Port_EnterCritical();
     // 检查是否是锁的持有者
-    if (!mutex->locked || mutex->owner_tcb != currentTask) {
+    if (mutex->owner_tcb != currentTask) {
         MyRTOS_Port_ExitCritical();
         return;
     }
-    // 从当前任务持有的互斥锁链表中移除此锁
-    if (currentTask->held_mutexes_head == mutex) {
+    const uint8_t old_priority = currentTask->priority;
+    uint8_t new_priority;
+    const uint8_t ceiling_priority = (mutex->savedPriority > mutex->ceiling) ? mutex->savedPriority : mutex->ceiling;
+    if (mutex->ceiling != 0 && currentTask->held_mutexes_head == mutex && mutex->exactRestore &&
+        old_priority == ceiling_priority) {
+        // 天花板互斥锁按获取的相反顺序释放, 且持有期间优先级未被其他因素改变:
+        // 直接恢复获取前的优先级, 不扫描持有链表和任何等待队列
         currentTask->held_mutexes_head = mutex->next_held_mutex;
+        new_priority = mutex->savedPriority;
     } else {
-        Mutex_t *p_iterator = currentTask->held_mutexes_head;
-        while (p_iterator != NULL && p_iterator->next_held_mutex != mutex)
-            p_iterator = p_iterator->next_held_mutex;
-        if (p_iterator != NULL)
-            p_iterator->next_held_mutex = mutex->next_held_mutex;
-    }
-    mutex->next_held_mutex = NULL;
-    // 优先级恢复：将任务优先级恢复到其基础优先级，或其仍然持有的其他互斥锁所要求的最高优先级
-    uint8_t new_priority = currentTask->basePriority;
-    Mutex_t *p_held_mutex = currentTask->held_mutexes_head;
-    while (p_held_mutex != NULL) {
-        if (p_held_mutex->eventList.head != NULL && p_held_mutex->eventList.head->priority > new_priority) {
-            new_priority = p_held_mutex->eventList.head->priority;
+        // 从当前任务持有的互斥锁链表中移除此锁
+        if (currentTask->held_mutexes_head == mutex) {
+            currentTask->held_mutexes_head = mutex->next_held_mutex;
+        } else {
+            Mutex_t *p_iterator = currentTask->held_mutexes_head;
+            while (p_iterator != NULL && p_iterator->next_held_mutex != mutex)
+                p_iterator = p_iterator->next_held_mutex;
+            if (p_iterator != NULL)
+                p_iterator->next_held_mutex = mutex->next_held_mutex;
         }
-        p_held_mutex = p_held_mutex->next_held_mutex;
+        // 优先级恢复：将任务优先级恢复到其基础优先级，或其仍然持有的其他互斥锁所要求的最高优先级
+        new_priority = mutexInheritedPriority(currentTask);
     }
-    task_set_priority(currentTask, new_priority);
+    mutex->next_held_mutex = NULL;
+    // 原地恢复: 任务留在新优先级就绪链表的头部并保留剩余时间片, 释放锁本身不是一次让出
+    if (currentTask->state == TASK_STATE_READY)
+        task_set_running_priority(currentTask, new_priority);
+    else
+        task_set_priority(currentTask, new_priority);
+    // 优先级回落后, 持有期间就绪的更高优先级任务应立即运行
+    if (new_priority < old_priority && scheduler_ready_preempts_current())
+        trigger_yield = 1;
     // 标记锁为未锁定
-    mutex->locked = 0;
     mutex->owner_tcb = NULL;
-    // 如果有任务在等待此锁，则唤醒优先级最高的那个
+    // 如果有任务在等待此锁，则唤醒等待队列头部的任务
     if (mutex->eventList.head != NULL) {
         Task_t *taskToWake = mutex->eventList.head;
         eventListRemove(taskToWake);
-        // 将锁的所有权直接转移给被唤醒的任务
-        mutex->locked = 1;
-        mutex->owner_tcb = taskToWake;
-        mutex->next_held_mutex = taskToWake->held_mutexes_head;
-        taskToWake->held_mutexes_head = mutex;
+        taskToWake->blockedOnMutex = NULL;
+        if (taskToWake->delay > 0) {
+            removeTaskFromDelayList(taskToWake);
+            taskToWake->delay = 0;
+        }
+        if (mutex->competitive) {
+            // 竞争释放: 锁保持空闲, 被唤醒的任务运行后重新竞争, 正在运行的任务可以立即再次获取。
+            // eventData 标记唤醒原因, 被唤醒的任务据此统计避免的护航
+            g_mutexStats.competitiveWakeups++;
+            taskToWake->eventData = mutex;
+        } else {
+            // 将锁的所有权直接转移给被唤醒的任务
+            mutex->owner_tcb = taskToWake;
+            mutex->next_held_mutex = taskToWake->held_mutexes_head;
+            taskToWake->held_mutexes_head = mutex;
+            // 天花板互斥锁把新的持有者提升到天花板; 新的持有者同时继承其余等待者的优先级
+            if (mutex->ceiling != 0)
+                mutexCeilingAcquire(mutex, taskToWake);
+            mutexPropagatePriority(taskToWake, NULL);
+        }
         addTaskToReadyList(taskToWake);
-        if (taskToWake->priority > currentTask->priority)
+        if (scheduler_task_preempts_current(taskToWake))
             trigger_yield = 1;
     }
     MyRTOS_Port_ExitCritical();
@@ -212,7 +512,7 @@ void Mutex_Unlock(MutexHandle_t mutex) {
 void Mutex_Lock_Recursive(MutexHandle_t mutex) {
     MyRTOS_Port_EnterCritical();
     // 如果已经持有该锁，增加递归计数
-    if (mutex->locked && mutex->owner_tcb == currentTask) {
+    if (mutex->owner_tcb == currentTask) {
         mutex->recursion_count++;
         MyRTOS_Port_ExitCritical();
         return;
@@ -233,7 +533,7 @@ void Mutex_Lock_Recursive(MutexHandle_t mutex) {
  */
 void Mutex_Unlock_Recursive(MutexHandle_t mutex) {
     MyRTOS_Port_EnterCritical();
-    if (mutex->locked && mutex->owner_tcb == currentTask) {
+    if (mutex->owner_tcb == currentTask) {
         mutex->recursion_count--;
         if (mutex->recursion_count == 0) {
             // 当递归计数归零时，才真正释放锁
@@ -246,3 +546,28 @@ void Mutex_Unlock_Recursive(MutexHandle_t mutex) {
         MyRTOS_Port_ExitCritical();
     }
 }
+
+/**
+ * @brief 获取互斥锁的统计信息
+ * @param stats_out [out] 统计信息
+ */
+void Mutex_GetStats(MutexStats_t *stats_out) {
+    if (stats_out == NULL)
+        return;
+    MyRTOS_Port_EnterCritical();
+    *stats_out = g_mutexStats;
+    MyRTOS_Port_ExitCritical();
+}
+
+/**
+ * @brief 等待互斥锁的任务被删除或挂起后, 撤销它对持有者的优先级提升
+ * @note  由任务模块在临界区中、任务已从事件列表中移除之后调用。
+ * @param task 被移出等待队列的任务
+ */
+void mutexWaitAborted(TaskHandle_t task) {
+    Mutex_t *mutex = task->blockedOnMutex;
+    if (mutex == NULL)
+        return;
+    task->blockedOnMutex = NULL;
+    mutexPropagatePriority(mutex->owner_tcb, mutex);
+}
@@ -8,13 +8,36 @@
 /*===========================================================================*
  * 外部函数声明
  *===========================================================================*/
-extern TaskHandle_t *get_delayed_task_list_head(void);
-extern TaskHandle_t *get_ready_task_list(uint8_t priority);
+extern TaskList_t *get_ready_task_list(uint8_t priority);
+
+/*===========================================================================*
+ * 私有函数
+ *===========================================================================*/
+
+/**
+ * @brief 初始化队列控制块
+ * @param queue 队列控制块
+ * @param storage 队列存储区
+ * @param isStatic 非0表示控制块和存储区由调用者提供
+ */
+static void queueInit(Queue_t *queue, uint32_t length, uint32_t itemSize, uint8_t *storage, uint8_t isStatic) {
+    queue->storage = storage;
+    queue->length = length;
+    queue->itemSize = itemSize;
+    queue->waitingCount = 0;
+    queue->writePtr = queue->storage;
+    queue->readPtr = queue->storage;
+    eventListInit(&queue->sendEventList); // 初始化等待发送的任务列表
+    eventListInit(&queue->receiveEventList); // 初始化等待接收的任务列表
+    queue->watchers = NULL;
+    queue->isStatic = isStatic;
+}
 
 /*===========================================================================*
  * 公开接口实现
  *===========================================================================*/
 
+#if MYRTOS_USE_HEAP == 1
 /**
  * @brief 创建一个消息队列
  * @param length 队列能够存储的最大项目数
@@ -29,25 +52,36 @@ QueueHandle_t Queue_Create(uint32_t length, uint32_t itemSize) {
     if (queue == NULL)
         return NULL;
     // 分配队列存储区内存
-    queue->storage = (uint8_t *) MyRTOS_Malloc(length * itemSize);
-    if (queue->storage == NULL) {
+    uint8_t *storage = (uint8_t *) MyRTOS_Malloc(length * itemSize);
+    if (storage == NULL) {
         MyRTOS_Free(queue);
         return NULL;
     }
-    // 初始化队列属性
-    queue->length = length;
-    queue->itemSize = itemSize;
-    queue->waitingCount = 0;
-    queue->writePtr = queue->storage;
-    queue->readPtr = queue->storage;
-    eventListInit(&queue->sendEventList); // 初始化等待发送的任务列表
-    eventListInit(&queue->receiveEventList); // 初始化等待接收的任务列表
+    queueInit(queue, length, itemSize, storage, 0);
+    return queue;
+}
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块和存储区创建一个消息队列
+ * @param length 队列能够存储的最大项目数
+ * @param itemSize 每个项目的大小（字节）
+ * @param storage_buffer 队列存储区, 至少 length * itemSize 字节
+ * @param queue_buffer 队列控制块存储
+ * @return 成功则返回队列句柄，失败则返回NULL
+ */
+QueueHandle_t Queue_CreateStatic(uint32_t length, uint32_t itemSize, uint8_t *storage_buffer,
+                                 StaticQueue_t *queue_buffer) {
+    if (length == 0 || itemSize == 0 || storage_buffer == NULL || queue_buffer == NULL)
+        return NULL;
+    Queue_t *queue = (Queue_t *) queue_buffer;
+    queueInit(queue, length, itemSize, storage_buffer, 1);
     return queue;
 }
 
 /**
  * @brief 删除一个消息队列
- * @note  会唤醒所有等待该队列的任务。
+ * @note  会唤醒所有等待该队列的任务, 并通知所有观察者。
  * @param delQueue 要删除的队列句柄
  */
 void Queue_Delete(QueueHandle_t delQueue) {
@@ -67,11 +101,38 @@ void Queue_Delete(QueueHandle_t delQueue) {
             eventListRemove(taskToWake);
             addTaskToReadyList(taskToWake);
         }
-        // 释放内存
-        MyRTOS_Free(queue->storage);
-        MyRTOS_Free(queue);
+        objectWatchNotify(&queue->watchers);
+#if MYRTOS_USE_HEAP == 1
+        // 释放内存, 静态队列的存储属于调用者
+        if (!queue->isStatic) {
+            MyRTOS_Free(queue->storage);
+            MyRTOS_Free(queue);
+        }
+#endif
+    }
+    MyRTOS_Port_ExitCritical();
+}
+
+/**
+ * @brief 设置队列等待队列的排队顺序
+ * @note  发送和接收两个等待队列使用相同的顺序。
+ * @param queue 队列句柄
+ * @param order 排队顺序
+ * @return 成功返回0，句柄无效或已有任务在等待返回-1
+ */
+int Queue_SetWaitOrder(QueueHandle_t queue, WaitOrder_t order) {
+    Queue_t *pQueue = queue;
+    if (pQueue == NULL)
+        return -1;
+    int result = -1;
+    MyRTOS_Port_EnterCritical();
+    if (pQueue->sendEventList.head == NULL && pQueue->receiveEventList.head == NULL) {
+        eventListSetFifo(&pQueue->sendEventList, order == WAIT_ORDER_FIFO);
+        eventListSetFifo(&pQueue->receiveEventList, order == WAIT_ORDER_FIFO);
+        result = 0;
     }
     MyRTOS_Port_ExitCritical();
+    return result;
 }
 
 /**
@@ -93,7 +154,7 @@ int Queue_Send(QueueHandle_t queue, const void *item, uint32_t block_ticks) {
             eventListRemove(taskToWake);
             // 如果该任务同时也在延迟列表中，从中移除
             if (taskToWake->delay > 0) {
-                removeTaskFromList(get_delayed_task_list_head(), taskToWake);
+                removeTaskFromDelayList(taskToWake);
                 taskToWake->delay = 0;
             }
             // 直接将数据拷贝给等待的任务
@@ -101,7 +162,7 @@ int Queue_Send(QueueHandle_t queue, const void *item, uint32_t block_ticks) {
             taskToWake->eventData = NULL;
             addTaskToReadyList(taskToWake);
             // 如果被唤醒的任务优先级更高，触发调度
-            if (taskToWake->priority > currentTask->priority)
+            if (scheduler_task_preempts_current(taskToWake))
                 MyRTOS_Port_Yield();
             MyRTOS_Port_ExitCritical();
             return 1;
@@ -115,6 +176,9 @@ int Queue_Send(QueueHandle_t queue, const void *item, uint32_t block_ticks) {
                 pQueue->writePtr = pQueue->storage;
             }
             pQueue->waitingCount++;
+            // 通知等待数据的观察者
+            if (pQueue->watchers != NULL && objectWatchNotify(&pQueue->watchers))
+                MyRTOS_Port_Yield();
             MyRTOS_Port_ExitCritical();
             return 1;
         }
@@ -130,7 +194,7 @@ int Queue_Send(QueueHandle_t queue, const void *item, uint32_t block_ticks) {
         currentTask->delay = 0;
         if (block_ticks != MYRTOS_MAX_DELAY) {
             currentTask->delay = MyRTOS_GetTick() + block_ticks;
-            addTaskToSortedDelayList(currentTask);
+            addTaskToDelayList(currentTask);
         }
         MyRTOS_Port_ExitCritical();
         MyRTOS_Port_Yield(); // 触发调度，任务进入阻塞
@@ -173,12 +237,12 @@ int Queue_Receive(QueueHandle_t queue, void *buffer, uint32_t block_ticks) {
                 eventListRemove(taskToWake);
                 // 如果该任务同时也在延迟列表中，从中移除
                 if (taskToWake->delay > 0) {
-                    removeTaskFromList(get_delayed_task_list_head(), taskToWake);
+                    removeTaskFromDelayList(taskToWake);
                     taskToWake->delay = 0;
                 }
                 addTaskToReadyList(taskToWake);
                 // 如果被唤醒的任务优先级更高，触发调度
-                if (taskToWake->priority > currentTask->priority)
+                if (scheduler_task_preempts_current(taskToWake))
                     MyRTOS_Port_Yield();
             }
             MyRTOS_Port_ExitCritical();
@@ -197,7 +261,7 @@ int Queue_Receive(QueueHandle_t queue, void *buffer, uint32_t block_ticks) {
         currentTask->delay = 0;
         if (block_ticks != MYRTOS_MAX_DELAY) {
             currentTask->delay = MyRTOS_GetTick() + block_ticks;
-            addTaskToSortedDelayList(currentTask);
+            addTaskToDelayList(currentTask);
         }
         MyRTOS_Port_ExitCritical();
         MyRTOS_Port_Yield(); // 触发调度，任务进入阻塞
@@ -212,3 +276,23 @@ int Queue_Receive(QueueHandle_t queue, void *buffer, uint32_t block_ticks) {
         return 0;
     }
 }
+
+/**
+ * @brief 在队列上挂载观察者
+ * @param queue 目标队列句柄
+ * @param watch 观察者
+ * @return 已挂载返回0，队列中已有数据返回1，参数无效返回-1
+ */
+int Queue_Watch(QueueHandle_t queue, ObjectWatch_t *watch) {
+    Queue_t *pQueue = queue;
+    if (pQueue == NULL || watch == NULL || watch->task == NULL)
+        return -1;
+    int result = 1;
+    MyRTOS_Port_EnterCritical();
+    if (pQueue->waitingCount == 0) {
+        objectWatchAttach(&pQueue->watchers, watch);
+        result = 0;
+    }
+    MyRTOS_Port_ExitCritical();
+    return result;
+}
@@ -9,12 +9,68 @@
  * 私有变量
  *===========================================================================*/
 
-// 按优先级组织的就绪任务链表数组
-static TaskHandle_t readyTaskLists[MYRTOS_MAX_PRIORITIES];
-// 延迟任务链表的头
-static TaskHandle_t delayedTaskListHead = NULL;
+// 按优先级组织的就绪任务链表数组 (带尾指针)
+static TaskList_t readyTaskLists[MYRTOS_MAX_PRIORITIES];
+// 延迟任务时间轮: 第0级每槽1个Tick, 第1级每槽 DELAY_WHEEL_SIZE 个Tick
+static TaskList_t delayWheel[DELAY_WHEEL_LEVELS][DELAY_WHEEL_SIZE];
+// 超出两级时间轮范围的远期延迟任务
+static TaskList_t delayOverflowList;
+// 时间轮当前所处的Tick, 与系统滴答计数同步推进
+static uint64_t delayWheelTick = 0;
+#if MYRTOS_MAX_PRIORITIES <= 32
 // 一个位图，用于快速查找当前存在的最高优先级的就绪任务
 static volatile uint32_t topReadyPriority = 0;
+#else
+// 两级就绪位图: 组位图的第 g 位表示 readyPriorityBitmap[g] 非空,
+// readyPriorityBitmap[g] 的第 b 位表示优先级 (g * 32 + b) 存在就绪任务
+#define READY_BITMAP_GROUPS ((MYRTOS_MAX_PRIORITIES + 31) / 32)
+static volatile uint32_t readyGroupBitmap = 0;
+static volatile uint32_t readyPriorityBitmap[READY_BITMAP_GROUPS];
+#endif
+// 调度器锁嵌套计数, 非0时推迟所有上下文切换
+static volatile uint32_t schedulerLockNesting = 0;
+// 调度器锁定期间有被推迟的上下文切换, 解锁时补发
+static volatile uint8_t schedulerYieldPending = 0;
+
+/*===========================================================================*
+ * 就绪位图操作
+ *===========================================================================*/
+
+#if MYRTOS_MAX_PRIORITIES <= 32
+static inline void readyBitmapSet(uint32_t priority) { topReadyPriority |= (1UL << priority); }
+
+static inline void readyBitmapClear(uint32_t priority) { topReadyPriority &= ~(1UL << priority); }
+
+static inline int readyBitmapIsEmpty(void) { return topReadyPriority == 0; }
+
+// 只有优先级0存在就绪任务
+static inline int readyBitmapOnlyLowest(void) { return topReadyPriority == 1UL; }
+
+// `__builtin_clz` 是一个GCC/Clang内置函数，用于计算前导零的数量，可以高效地找到最高置位
+static inline uint32_t readyBitmapHighest(void) { return 31 - __builtin_clz(topReadyPriority); }
+#else
+static inline void readyBitmapSet(uint32_t priority) {
+    readyPriorityBitmap[priority >> 5] |= (1UL << (priority & 31));
+    readyGroupBitmap |= (1UL << (priority >> 5));
+}
+
+static inline void readyBitmapClear(uint32_t priority) {
+    readyPriorityBitmap[priority >> 5] &= ~(1UL << (priority & 31));
+    if (readyPriorityBitmap[priority >> 5] == 0) {
+        readyGroupBitmap &= ~(1UL << (priority >> 5));
+    }
+}
+
+static inline int readyBitmapIsEmpty(void) { return readyGroupBitmap == 0; }
+
+static inline int readyBitmapOnlyLowest(void) { return readyGroupBitmap == 1UL && readyPriorityBitmap[0] == 1UL; }
+
+// 两次前导零计数: 先找最高的非空组, 再找组内的最高优先级
+static inline uint32_t readyBitmapHighest(void) {
+    const uint32_t group = 31 - __builtin_clz(readyGroupBitmap);
+    return (group << 5) + (31 - __builtin_clz(readyPriorityBitmap[group]));
+}
+#endif
 
 /*===========================================================================*
  * 内部函数实现
@@ -22,60 +78,210 @@ static volatile uint32_t topReadyPriority = 0;
 
 /**
  * @brief 从一个通用双向链表中移除任务
- * @param ppListHead 指向链表头指针的指针
+ * @param pList 任务所在的链表
  * @param taskToRemove 要移除的任务句柄
  */
-void removeTaskFromList(TaskHandle_t *ppListHead, TaskHandle_t taskToRemove) {
-    if (taskToRemove == NULL)
+void removeTaskFromList(TaskList_t *pList, TaskHandle_t taskToRemove) {
+    if (pList == NULL || taskToRemove == NULL)
         return;
     // 更新前一个节点的 next 指针
     if (taskToRemove->pPrevGeneric != NULL) {
         taskToRemove->pPrevGeneric->pNextGeneric = taskToRemove->pNextGeneric;
     } else {
         // 如果是头节点，则更新链表头
-        *ppListHead = taskToRemove->pNextGeneric;
+        pList->head = taskToRemove->pNextGeneric;
     }
     // 更新后一个节点的 prev 指针
     if (taskToRemove->pNextGeneric != NULL) {
         taskToRemove->pNextGeneric->pPrevGeneric = taskToRemove->pPrevGeneric;
+    } else {
+        // 如果是尾节点，则更新链表尾
+        pList->tail = taskToRemove->pPrevGeneric;
     }
     // 清理任务自身的链表指针
     taskToRemove->pNextGeneric = NULL;
     taskToRemove->pPrevGeneric = NULL;
     // 如果是从就绪链表中移除，需要检查是否需要清除优先级位图中的对应位
     if (taskToRemove->state == TASK_STATE_READY) {
-        if (readyTaskLists[taskToRemove->priority] == NULL) {
-            topReadyPriority &= ~(1UL << taskToRemove->priority);
+        if (readyTaskLists[taskToRemove->priority].head == NULL) {
+            readyBitmapClear(taskToRemove->priority);
         }
     }
 }
 
 /**
- * @brief 将任务添加到按唤醒时间排序的延迟链表中
- * @param task 要添加的任务句柄
+ * @brief 将任务 O(1) 插入到指定链表头部
+ * @param pList 目标链表
+ * @param task 要插入的任务
  */
-void addTaskToSortedDelayList(TaskHandle_t task) {
-    const uint64_t wakeUpTime = task->delay;
-    // 插入到链表头
-    if (delayedTaskListHead == NULL || wakeUpTime < delayedTaskListHead->delay) {
-        task->pNextGeneric = delayedTaskListHead;
-        task->pPrevGeneric = NULL;
-        if (delayedTaskListHead != NULL)
-            delayedTaskListHead->pPrevGeneric = task;
-        delayedTaskListHead = task;
+static void prependTaskToList(TaskList_t *pList, TaskHandle_t task) {
+    task->pPrevGeneric = NULL;
+    task->pNextGeneric = pList->head;
+    if (pList->head == NULL) {
+        pList->tail = task;
     } else {
-        // 遍历链表找到合适的插入位置
-        Task_t *iterator = delayedTaskListHead;
-        while (iterator->pNextGeneric != NULL && iterator->pNextGeneric->delay <= wakeUpTime) {
-            iterator = iterator->pNextGeneric;
+        pList->head->pPrevGeneric = task;
+    }
+    pList->head = task;
+}
+
+/**
+ * @brief 将任务 O(1) 追加到指定链表末尾
+ * @param pList 目标链表
+ * @param task 要追加的任务
+ */
+static void appendTaskToList(TaskList_t *pList, TaskHandle_t task) {
+    task->pNextGeneric = NULL;
+    task->pPrevGeneric = pList->tail;
+    if (pList->tail == NULL) {
+        pList->head = task;
+    } else {
+        pList->tail->pNextGeneric = task;
+    }
+    pList->tail = task;
+}
+
+#if MYRTOS_USE_EDF == 1
+/**
+ * @brief 将任务按绝对截止时间插入EDF优先级的就绪链表
+ * @note  截止时间相同的任务按到达顺序排列。链表头始终是截止时间最早的任务。
+ * @param pList 目标链表
+ * @param task 要插入的任务
+ */
+static void insertTaskByDeadline(TaskList_t *pList, TaskHandle_t task) {
+    Task_t *next = pList->head;
+    while (next != NULL && next->absDeadline <= task->absDeadline) {
+        next = next->pNextGeneric;
+    }
+    if (next == NULL) {
+        appendTaskToList(pList, task);
+        return;
+    }
+    task->pNextGeneric = next;
+    task->pPrevGeneric = next->pPrevGeneric;
+    if (next->pPrevGeneric != NULL) {
+        next->pPrevGeneric->pNextGeneric = task;
+    } else {
+        pList->head = task;
+    }
+    next->pPrevGeneric = task;
+}
+#endif
+
+/**
+ * @brief 根据唤醒时间选择任务在时间轮中应处的槽位
+ * @note  唤醒时间与当前Tick位于同一轮内时放入第0级, 轮数之差小于 DELAY_WHEEL_SIZE
+ *        时放入第1级, 否则放入溢出链表。
+ * @param wakeUpTime 任务的绝对唤醒时间
+ * @return 对应的槽位链表
+ */
+static TaskList_t *delayWheelSelectSlot(uint64_t wakeUpTime) {
+    // 级联时可能遇到本Tick到期的任务, 它们属于当前槽位
+    if (wakeUpTime < delayWheelTick) {
+        wakeUpTime = delayWheelTick;
+    }
+    const uint64_t wakeRound = wakeUpTime >> MYRTOS_DELAY_WHEEL_BITS;
+    const uint64_t nowRound = delayWheelTick >> MYRTOS_DELAY_WHEEL_BITS;
+    if (wakeRound == nowRound) {
+        return &delayWheel[0][wakeUpTime & DELAY_WHEEL_MASK];
+    }
+    if (wakeRound - nowRound < DELAY_WHEEL_SIZE) {
+        return &delayWheel[1][wakeRound & DELAY_WHEEL_MASK];
+    }
+    return &delayOverflowList;
+}
+
+/**
+ * @brief 将一个槽位中的全部任务按当前时间重新放置 (级联)
+ * @param pSlot 要级联的槽位
+ */
+static void delayWheelCascade(TaskList_t *pSlot) {
+    while (pSlot->head != NULL) {
+        Task_t *task = pSlot->head;
+        removeTaskFromList(pSlot, task);
+        task->pDelayList = delayWheelSelectSlot(task->delay);
+        appendTaskToList(task->pDelayList, task);
+    }
+}
+
+/**
+ * @brief 将任务添加到延迟时间轮中
+ * @note  按 task->delay 中的绝对唤醒时间计算槽位后尾插, O(1)。
+ * @param task 要添加的任务句柄
+ */
+void addTaskToDelayList(TaskHandle_t task) {
+    // 当前Tick的槽位已经处理过, 已到期的任务放到下一个Tick唤醒
+    const uint64_t wakeUpTime = (task->delay > delayWheelTick) ? task->delay : delayWheelTick + 1;
+    task->pDelayList = delayWheelSelectSlot(wakeUpTime);
+    appendTaskToList(task->pDelayList, task);
+}
+
+/**
+ * @brief 将任务从延迟时间轮中移除
+ * @note  TCB 记录了所在槽位, 因此取消超时同样是 O(1)。
+ * @param task 要移除的任务句柄
+ */
+void removeTaskFromDelayList(TaskHandle_t task) {
+    if (task == NULL || task->pDelayList == NULL)
+        return;
+    removeTaskFromList(task->pDelayList, task);
+    task->pDelayList = NULL;
+}
+
+/**
+ * @brief 将时间轮推进到指定Tick, 并返回该Tick到期的任务链表
+ * @note  由滴答中断每个Tick调用一次。级联只在跨轮时发生: 第1级的任务最多下放一次,
+ *        溢出链表每 2^(2*bits) 个Tick才回填一次, 其余Tick的处理量只取决于本Tick真正到期的任务数。
+ *        最坏情况: 每 2^bits 个Tick的跨轮Tick要在中断中逐个重新放置该轮的全部任务, 与唤醒时间落在同一轮
+ *        (2^bits 个Tick) 内的任务数成正比; 每 2^(2*bits) 个Tick的回填Tick还要遍历整个溢出链表,
+ *        与超时超过 2^(2*bits) 个Tick的任务数成正比。单个任务的放置是 O(1) 的, 但这两种Tick的
+ *        中断时间都随延迟任务总数线性增长。大量任务使用相同的较长超时时, 可增大 MYRTOS_DELAY_WHEEL_BITS
+ *        减少回填的频率, 或错开它们的唤醒时间以分散跨轮的级联。
+ * @param currentTick 新的系统滴答计数
+ * @return 本Tick到期的任务链表 (调用者负责逐个移除并唤醒)
+ */
+TaskList_t *delayListAdvance(uint64_t currentTick) {
+    delayWheelTick = currentTick;
+    if ((currentTick & DELAY_WHEEL_MASK) == 0) {
+        const uint64_t nowRound = currentTick >> MYRTOS_DELAY_WHEEL_BITS;
+        // 第1级转完一圈时, 把溢出链表中进入范围的任务放回时间轮
+        if ((nowRound & DELAY_WHEEL_MASK) == 0) {
+            TaskList_t pending = delayOverflowList;
+            delayOverflowList.head = NULL;
+            delayOverflowList.tail = NULL;
+            delayWheelCascade(&pending);
+        }
+        // 将第1级中属于本轮的任务下放到第0级
+        delayWheelCascade(&delayWheel[1][nowRound & DELAY_WHEEL_MASK]);
+    }
+    return &delayWheel[0][currentTick & DELAY_WHEEL_MASK];
+}
+
+/**
+ * @brief 计算时间轮中最近一次需要处理的Tick
+ * @note  供低功耗空闲模式使用。第1级槽位和溢出链表只能给出其级联发生的Tick,
+ *        这是一个保守的下界: 到达该Tick后任务会被下放, 再次计算即可得到精确值。
+ * @return 下一次需要处理的绝对Tick, 若没有任何延迟任务则返回 UINT64_MAX
+ */
+uint64_t delayListNextWakeTick(void) {
+    const uint64_t nowRound = delayWheelTick >> MYRTOS_DELAY_WHEEL_BITS;
+    // 第0级: 本轮剩余的槽位
+    for (uint64_t tick = delayWheelTick + 1; (tick >> MYRTOS_DELAY_WHEEL_BITS) == nowRound; tick++) {
+        if (delayWheel[0][tick & DELAY_WHEEL_MASK].head != NULL) {
+            return tick;
         }
-        // 插入到链表中间或尾部
-        task->pNextGeneric = iterator->pNextGeneric;
-        if (iterator->pNextGeneric != NULL)
-            iterator->pNextGeneric->pPrevGeneric = task;
-        iterator->pNextGeneric = task;
-        task->pPrevGeneric = iterator;
     }
+    // 第1级: 最近一个非空槽位所在轮的起点
+    for (uint64_t round = nowRound + 1; round < nowRound + DELAY_WHEEL_SIZE; round++) {
+        if (delayWheel[1][round & DELAY_WHEEL_MASK].head != NULL) {
+            return round << MYRTOS_DELAY_WHEEL_BITS;
+        }
+    }
+    // 溢出链表: 下一次回填发生在第1级转完一圈时
+    if (delayOverflowList.head != NULL) {
+        return ((nowRound >> MYRTOS_DELAY_WHEEL_BITS) + 1) << (2 * MYRTOS_DELAY_WHEEL_BITS);
+    }
+    return UINT64_MAX;
 }
 
 /**
@@ -83,23 +289,20 @@ void addTaskToSortedDelayList(TaskHandle_t task) {
  * @param task 要添加的任务句柄
  */
 void addTaskToReadyList(TaskHandle_t task) {
-    if (task == NULL || task->priority >= MYRTOS_MAX_PRIORITIES)
+    if (task == NULL || PRIORITY_OUT_OF_RANGE(task->priority))
         return;
     MyRTOS_Port_EnterCritical(); {
         // 设置对应优先级的位图标志
-        topReadyPriority |= (1UL << task->priority);
-        task->pNextGeneric = NULL;
-        // 将任务添加到就绪链表末尾
-        if (readyTaskLists[task->priority] == NULL) {
-            readyTaskLists[task->priority] = task;
-            task->pPrevGeneric = NULL;
-        } else {
-            Task_t *pLast = readyTaskLists[task->priority];
-            while (pLast->pNextGeneric != NULL)
-                pLast = pLast->pNextGeneric;
-            pLast->pNextGeneric = task;
-            task->pPrevGeneric = pLast;
-        }
+        readyBitmapSet(task->priority);
+#if MYRTOS_USE_EDF == 1
+        if (task->priority == MYRTOS_EDF_PRIORITY) {
+            // EDF优先级的就绪链表按截止时间排序
+            insertTaskByDeadline(&readyTaskLists[task->priority], task);
+        } else
+#endif
+        // 将任务 O(1) 追加到就绪链表末尾, 并领取一个完整的时间片
+        appendTaskToList(&readyTaskLists[task->priority], task);
+        task->timeSliceRemaining = task->timeSlice;
         // 更新任务状态
         task->state = TASK_STATE_READY;
     }
@@ -108,60 +311,104 @@ void addTaskToReadyList(TaskHandle_t task) {
 
 /**
  * @brief 初始化一个事件列表
+ * @note  新列表按优先级排序, 可通过 eventListSetFifo 改为先进先出。
  * @param pEventList 指向要初始化的事件列表的指针
  */
 void eventListInit(EventList_t *pEventList) {
     pEventList->head = NULL;
+    pEventList->tail = NULL;
+    pEventList->fifo = 0;
+}
+
+/**
+ * @brief 设置事件列表的等待顺序
+ * @note  只应在列表为空时调用, 已在等待的任务不会被重新排序。
+ * @param pEventList 目标事件列表
+ * @param fifo 1 为先进先出, 0 为按优先级
+ */
+void eventListSetFifo(EventList_t *pEventList, uint8_t fifo) {
+    pEventList->fifo = fifo ? 1 : 0;
 }
 
 /**
- * @brief 将任务按优先级插入到事件等待列表中
+ * @brief 将任务插入到事件等待列表中
+ * @note  按优先级排序的列表中, 新任务排在所有优先级不低于它的任务之后, 同优先级先到先得。
+ *        从尾部向前查找插入位置, 常见的同优先级等待者是 O(1) 的尾部追加。
  * @param pEventList 目标事件列表
  * @param taskToInsert 要插入的任务
  */
 void eventListInsert(EventList_t *pEventList, TaskHandle_t taskToInsert) {
     taskToInsert->pEventList = pEventList;
-    // 插入到链表头（如果新任务优先级最高）
-    if (pEventList->head == NULL || pEventList->head->priority <= taskToInsert->priority) {
-        taskToInsert->pNextEvent = pEventList->head;
+    // 找到插入位置的前一个节点, NULL 表示插入到链表头
+    Task_t *prev = pEventList->tail;
+    if (!pEventList->fifo) {
+        while (prev != NULL && prev->priority < taskToInsert->priority) {
+            prev = prev->pPrevEvent;
+        }
+    }
+    Task_t *next = (prev != NULL) ? prev->pNextEvent : pEventList->head;
+    taskToInsert->pPrevEvent = prev;
+    taskToInsert->pNextEvent = next;
+    if (prev != NULL) {
+        prev->pNextEvent = taskToInsert;
+    } else {
         pEventList->head = taskToInsert;
+    }
+    if (next != NULL) {
+        next->pPrevEvent = taskToInsert;
     } else {
-        // 遍历找到按优先级排序的正确位置
-        Task_t *iterator = pEventList->head;
-        while (iterator->pNextEvent != NULL && iterator->pNextEvent->priority > taskToInsert->priority) {
-            iterator = iterator->pNextEvent;
-        }
-        taskToInsert->pNextEvent = iterator->pNextEvent;
-        iterator->pNextEvent = taskToInsert;
+        pEventList->tail = taskToInsert;
     }
 }
 
 /**
  * @brief 从任务当前等待的事件列表中移除该任务
+ * @note  O(1) 操作, 超时唤醒、删除和挂起等待中的任务都不需要遍历列表。
  * @param taskToRemove 要移除的任务
  */
 void eventListRemove(TaskHandle_t taskToRemove) {
     if (taskToRemove->pEventList == NULL)
         return;
     EventList_t *pEventList = taskToRemove->pEventList;
-    // 如果任务是事件列表的头节点
-    if (pEventList->head == taskToRemove) {
+    if (taskToRemove->pPrevEvent != NULL) {
+        taskToRemove->pPrevEvent->pNextEvent = taskToRemove->pNextEvent;
+    } else {
         pEventList->head = taskToRemove->pNextEvent;
+    }
+    if (taskToRemove->pNextEvent != NULL) {
+        taskToRemove->pNextEvent->pPrevEvent = taskToRemove->pPrevEvent;
     } else {
-        // 遍历查找并移除任务
-        Task_t *iterator = pEventList->head;
-        while (iterator != NULL && iterator->pNextEvent != taskToRemove) {
-            iterator = iterator->pNextEvent;
-        }
-        if (iterator != NULL) {
-            iterator->pNextEvent = taskToRemove->pNextEvent;
-        }
+        pEventList->tail = taskToRemove->pPrevEvent;
     }
     // 清理任务中的事件列表相关指针
     taskToRemove->pNextEvent = NULL;
+    taskToRemove->pPrevEvent = NULL;
     taskToRemove->pEventList = NULL;
 }
 
+/**
+ * @brief 获取事件列表中等待任务的最高优先级
+ * @note  按优先级排序的列表直接取头节点; 先进先出的列表需要遍历。
+ * @param pEventList 目标事件列表
+ * @param floor 列表为空或所有等待者都低于该值时的返回值
+ * @return 等待任务的最高优先级与 floor 中的较大者
+ */
+uint8_t eventListHighestPriority(const EventList_t *pEventList, uint8_t floor) {
+    const Task_t *iterator = pEventList->head;
+    if (iterator == NULL) {
+        return floor;
+    }
+    if (!pEventList->fifo) {
+        return iterator->priority > floor ? iterator->priority : floor;
+    }
+    for (; iterator != NULL; iterator = iterator->pNextEvent) {
+        if (iterator->priority > floor) {
+            floor = iterator->priority;
+        }
+    }
+    return floor;
+}
+
 /**
  * @brief 动态改变任务的优先级
  * @param task 目标任务句柄
@@ -177,12 +424,171 @@ void task_set_priority(TaskHandle_t task, uint8_t newPriority) {
         task->priority = newPriority;
         addTaskToReadyList(task);
         MyRTOS_Port_ExitCritical();
+    } else if (task->pEventList != NULL && !task->pEventList->fifo) {
+        // 任务正在按优先级排序的事件列表中等待, 需要重新排队以保持列表有序
+        MyRTOS_Port_EnterCritical();
+        EventList_t *pEventList = task->pEventList;
+        eventListRemove(task);
+        task->priority = newPriority;
+        eventListInsert(pEventList, task);
+        MyRTOS_Port_ExitCritical();
     } else {
-        // 如果任务不是就绪状态，直接修改优先级即可
+        // 其他情况直接修改优先级即可
         task->priority = newPriority;
     }
 }
 
+/**
+ * @brief 修改正在运行的任务的优先级, 并把它放在新优先级就绪链表的头部
+ * @note  用于互斥锁的获取和释放: 任务仍在运行, 放在头部且不重新领取时间片, 优先级的提升与恢复
+ *        不会变成一次隐式的让出, 同优先级的其他任务 (可能也使用同一把锁) 不会因为一次普通的
+ *        重新调度而先于它运行。恢复后若有更高优先级的任务就绪, 由调用者触发调度。必须在临界区中调用。
+ * @param task 正在运行的任务 (处于就绪状态)
+ * @param newPriority 新的优先级
+ */
+void task_set_running_priority(TaskHandle_t task, uint8_t newPriority) {
+    if (task->priority == newPriority)
+        return;
+    removeTaskFromList(&readyTaskLists[task->priority], task);
+    task->priority = newPriority;
+#if MYRTOS_USE_EDF == 1
+    if (newPriority == MYRTOS_EDF_PRIORITY) {
+        insertTaskByDeadline(&readyTaskLists[newPriority], task);
+    } else
+#endif
+    prependTaskToList(&readyTaskLists[newPriority], task);
+    readyBitmapSet(newPriority);
+}
+
+/**
+ * @brief 将就绪任务移动到其优先级就绪链表的末尾, 并重新领取时间片
+ * @param task 处于就绪状态的任务
+ * @return 如果同优先级还有其他就绪任务 (即需要切换), 返回1, 否则返回0
+ */
+int readyListRotate(TaskHandle_t task) {
+    TaskList_t *pList = &readyTaskLists[task->priority];
+    task->timeSliceRemaining = task->timeSlice;
+#if MYRTOS_USE_EDF == 1
+    // EDF优先级的顺序由截止时间决定, 不参与轮转
+    if (task->priority == MYRTOS_EDF_PRIORITY) {
+        return 0;
+    }
+#endif
+    if (pList->head == pList->tail) {
+        return 0;
+    }
+    removeTaskFromList(pList, task);
+    appendTaskToList(pList, task);
+    return 1;
+}
+
+#if MYRTOS_USE_BUDGET == 1
+/**
+ * @brief 向当前任务收取一个Tick的CPU预算
+ * @note  由滴答中断调用, 实现可延迟服务器: 预算在周期边界一次性补满 (不运行的任务在下次被收取时补),
+ *        用完后任务从就绪链表移入延迟时间轮, 到周期结束时由时间轮照常唤醒。
+ *        持有互斥锁或锁住调度器的任务暂不挂起, 以免等待该锁的任务被一起拖到下个周期。
+ * @param now 当前系统滴答计数
+ * @return 当前任务因预算用完被挂起 (需要切换) 时返回1, 否则返回0
+ */
+int scheduler_budget_tick(uint64_t now) {
+    TaskHandle_t task = currentTask;
+    if (task == NULL || task->budget == 0 || task->state != TASK_STATE_READY) {
+        return 0;
+    }
+    if (now >= task->budgetPeriodEnd) {
+        // 进入新的周期 (可能已跨过多个周期), 预算补满
+        const uint64_t periods = (now - task->budgetPeriodEnd) / task->budgetPeriod + 1;
+        task->budgetPeriodEnd += periods * task->budgetPeriod;
+        task->budgetUsed = 0;
+    }
+    task->budgetUsed++;
+    if (task->budgetUsed < task->budget || task->held_mutexes_head != NULL || schedulerLockNesting != 0) {
+        return 0;
+    }
+    task->budgetExhaustions++;
+    removeTaskFromList(&readyTaskLists[task->priority], task);
+    task->delay = task->budgetPeriodEnd;
+    task->state = TASK_STATE_DELAYED;
+    addTaskToDelayList(task);
+    return 1;
+}
+#endif
+
+/**
+ * @brief 消耗当前任务一个Tick的时间片
+ * @note  由滴答中断调用。时间片耗尽时, 当前任务被轮转到同优先级就绪链表末尾。
+ *        时间片为0的任务不参与轮转, 一直运行到阻塞或主动让出。
+ * @return 时间片耗尽且需要切换到同优先级的其他任务时返回1, 否则返回0
+ */
+int scheduler_time_slice_tick(void) {
+    TaskHandle_t task = currentTask;
+    if (task == NULL || task->state != TASK_STATE_READY || task->timeSlice == 0) {
+        return 0;
+    }
+    if (task->timeSliceRemaining > 1) {
+        task->timeSliceRemaining--;
+        return 0;
+    }
+    // 持有天花板互斥锁期间不轮转: 同优先级的其他任务可能也使用这把锁, 天花板协议要求它们此时不能运行。
+    // 天花板互斥锁之上可能还嵌套着后获取的优先级继承互斥锁, 因此检查整个持有链表。
+    // 剩余时间片停在1, 释放后的第一个Tick再轮转
+    for (const Mutex_t *held = task->held_mutexes_head; held != NULL; held = held->next_held_mutex) {
+        if (held->ceiling != 0) {
+            return 0;
+        }
+    }
+    return readyListRotate(task);
+}
+
+/**
+ * @brief 获取任务当前生效的抢占阈值
+ * @note  只对正在运行 (就绪状态) 的任务有意义。优先级继承可能把任务优先级提升到阈值之上,
+ *        此时以提升后的优先级为准; 正在阻塞或被删除的任务不设阈值, 任何就绪任务都可以接替它。
+ * @param task 目标任务
+ * @return 只有优先级高于该值的任务才能抢占它
+ */
+uint8_t scheduler_preempt_threshold(TaskHandle_t task) {
+    if (task->state != TASK_STATE_READY) {
+        return task->priority;
+    }
+    return (task->preemptThreshold > task->priority) ? task->preemptThreshold : task->priority;
+}
+
+/**
+ * @brief 判断一个刚变为就绪的任务是否应该抢占当前任务
+ * @note  优先级高于当前任务抢占阈值的任务抢占; 两者同在EDF优先级时, 截止时间更早的任务抢占。
+ * @param task 刚变为就绪的任务
+ * @return 需要抢占返回1, 否则返回0
+ */
+int scheduler_task_preempts_current(TaskHandle_t task) {
+    if (task->priority != currentTask->priority) {
+        return task->priority > currentTask->priority && task->priority > scheduler_preempt_threshold(currentTask);
+    }
+#if MYRTOS_USE_EDF == 1
+    return task->priority == MYRTOS_EDF_PRIORITY && task->absDeadline < currentTask->absDeadline;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief 判断是否有就绪任务应该抢占当前任务
+ * @note  用于当前任务降低自身优先级 (释放互斥锁时恢复优先级) 之后, 决定是否需要让出CPU。
+ * @return 需要抢占返回1, 否则返回0
+ */
+int scheduler_ready_preempts_current(void) {
+    return !readyBitmapIsEmpty() && readyBitmapHighest() > scheduler_preempt_threshold(currentTask);
+}
+
+/**
+ * @brief 判断当前是否只有空闲任务处于就绪状态
+ * @return 只有空闲任务就绪返回1, 否则返回0
+ */
+int scheduler_only_idle_ready(void) {
+    return readyBitmapOnlyLowest() && readyTaskLists[0].head == idleTask && readyTaskLists[0].tail == idleTask;
+}
+
 /*===========================================================================*
  * 公开接口实现
  *===========================================================================*/
@@ -196,43 +602,40 @@ void task_set_priority(TaskHandle_t task, uint8_t newPriority) {
 void *schedule_next_task(void) {
     TaskHandle_t prevTask = currentTask;
     TaskHandle_t nextTaskToRun = NULL;
+    // 调度器已锁定: 继续运行当前任务, 解锁时再补发这次调度。
+    // 当前任务为NULL (正在删除自身) 时没有可以继续运行的任务, 必须切换
+    if (schedulerLockNesting != 0 && prevTask != NULL) {
+        schedulerYieldPending = 1;
+        return prevTask->sp;
+    }
     // 广播任务切出事件
-    if (prevTask) {
+    if (prevTask && extension_event_wanted(KERNEL_EVENT_TASK_SWITCH_OUT)) {
         KernelEventData_t eventData = {.eventType = KERNEL_EVENT_TASK_SWITCH_OUT, .task = prevTask};
         broadcast_event(&eventData);
     }
+#if MYRTOS_USE_DEFERRED_CALL == 1
+    // 中断投递了延迟调用时只挂起了 PendSV, 在这里唤醒守护任务
+    deferred_wake_daemon();
+#endif
     // 如果没有就绪任务，则选择空闲任务
-    if (topReadyPriority == 0) {
+    if (readyBitmapIsEmpty()) {
         nextTaskToRun = idleTask;
     } else {
-        // 找到最高优先级的就绪任务
-        // `__builtin_clz` 是一个GCC/Clang内置函数，用于计算前导零的数量，可以高效地找到最高置位
-        uint32_t highestPriority = 31 - __builtin_clz(topReadyPriority);
-        nextTaskToRun = readyTaskLists[highestPriority];
-        // 实现同优先级任务的轮转调度 (Round-Robin)
-        if (nextTaskToRun != NULL && nextTaskToRun->pNextGeneric != NULL) {
-            // 将当前头节点移动到链表尾部
-            readyTaskLists[highestPriority] = nextTaskToRun->pNextGeneric;
-            nextTaskToRun->pNextGeneric->pPrevGeneric = NULL;
-            Task_t *pLast = readyTaskLists[highestPriority];
-            if (pLast != NULL) {
-                while (pLast->pNextGeneric != NULL)
-                    pLast = pLast->pNextGeneric;
-                pLast->pNextGeneric = nextTaskToRun;
-                nextTaskToRun->pPrevGeneric = pLast;
-                nextTaskToRun->pNextGeneric = NULL;
-            } else {
-                // 如果链表中只有一个元素，则它仍然是头
-                readyTaskLists[highestPriority] = nextTaskToRun;
-                nextTaskToRun->pPrevGeneric = NULL;
-                nextTaskToRun->pNextGeneric = NULL;
-            }
+        // 通过就绪位图 O(1) 找到最高优先级的就绪任务
+        uint32_t highestPriority = readyBitmapHighest();
+        // 取链表头部的任务运行。同优先级任务之间的轮转只在时间片耗尽 (scheduler_time_slice_tick)
+        // 或任务主动让出 (Task_Yield) 时发生, 事件引起的重新调度不会打乱顺序
+        nextTaskToRun = readyTaskLists[highestPriority].head;
+        // 更高优先级的任务没有超过当前任务的抢占阈值时, 当前任务继续运行
+        if (prevTask != NULL && highestPriority > prevTask->priority &&
+            highestPriority <= scheduler_preempt_threshold(prevTask)) {
+            nextTaskToRun = prevTask;
         }
     }
     // 更新当前任务
     currentTask = nextTaskToRun;
     // 广播任务切入事件
-    if (currentTask) {
+    if (currentTask && extension_event_wanted(KERNEL_EVENT_TASK_SWITCH_IN)) {
         KernelEventData_t eventData = {.eventType = KERNEL_EVENT_TASK_SWITCH_IN, .task = currentTask};
         broadcast_event(&eventData);
     }
@@ -249,30 +652,69 @@ void *schedule_next_task(void) {
  */
 void MyRTOS_Schedule(void) { schedule_next_task(); }
 
+/**
+ * @brief 锁定调度器
+ * @note  锁定期间中断照常响应, 任务照常被唤醒, 但不会发生任何上下文切换, 被推迟的切换在
+ *        最外层解锁时补发。用于保护只在任务上下文中访问、但遍历耗时较长的数据 (内存堆、全局任务链表),
+ *        以免长时间关中断。可以嵌套。锁定期间不得调用任何会阻塞的接口。
+ */
+void MyRTOS_Schedule_Lock(void) {
+    // 嵌套计数只在任务上下文中成对修改, 被打断的任务恢复后看到的仍是自己写入前的值
+    schedulerLockNesting++;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief 解锁调度器
+ * @note  最外层解锁时, 如果锁定期间有被推迟的调度, 立即触发一次上下文切换。
+ */
+void MyRTOS_Schedule_Unlock(void) {
+    int trigger_yield = 0;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    MyRTOS_Port_EnterCritical();
+    if (schedulerLockNesting > 0 && --schedulerLockNesting == 0 && schedulerYieldPending) {
+        schedulerYieldPending = 0;
+        trigger_yield = 1;
+    }
+    MyRTOS_Port_ExitCritical();
+    if (trigger_yield) {
+        MyRTOS_Port_Yield();
+    }
+}
+
 /**
  * @brief 初始化调度器内部状态
  * @note  由 MyRTOS_Init 调用
  */
 void scheduler_init(void) {
     for (int i = 0; i < MYRTOS_MAX_PRIORITIES; i++) {
-        readyTaskLists[i] = NULL;
+        readyTaskLists[i].head = NULL;
+        readyTaskLists[i].tail = NULL;
+    }
+    for (int level = 0; level < DELAY_WHEEL_LEVELS; level++) {
+        for (uint32_t slot = 0; slot < DELAY_WHEEL_SIZE; slot++) {
+            delayWheel[level][slot].head = NULL;
+            delayWheel[level][slot].tail = NULL;
+        }
     }
-    delayedTaskListHead = NULL;
+    delayOverflowList.head = NULL;
+    delayOverflowList.tail = NULL;
+    delayWheelTick = 0;
+#if MYRTOS_MAX_PRIORITIES <= 32
     topReadyPriority = 0;
-}
-
-/**
- * @brief 获取延迟任务链表头（内部使用）
- */
-TaskHandle_t *get_delayed_task_list_head(void) {
-    return &delayedTaskListHead;
+#else
+    readyGroupBitmap = 0;
+    for (int i = 0; i < READY_BITMAP_GROUPS; i++) {
+        readyPriorityBitmap[i] = 0;
+    }
+#endif
 }
 
 /**
  * @brief 获取就绪任务链表（内部使用）
  */
-TaskHandle_t *get_ready_task_list(uint8_t priority) {
-    if (priority >= MYRTOS_MAX_PRIORITIES)
+TaskList_t *get_ready_task_list(uint8_t priority) {
+    if (PRIORITY_OUT_OF_RANGE(priority))
         return NULL;
     return &readyTaskLists[priority];
 }
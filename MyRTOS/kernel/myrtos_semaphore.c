@@ -8,13 +8,65 @@
 /*===========================================================================*
  * 外部函数声明
  *===========================================================================*/
-extern TaskHandle_t *get_delayed_task_list_head(void);
-extern TaskHandle_t *get_ready_task_list(uint8_t priority);
+extern TaskList_t *get_ready_task_list(uint8_t priority);
+
+/*===========================================================================*
+ * 私有函数
+ *===========================================================================*/
+
+/**
+ * @brief 初始化信号量控制块
+ * @param isStatic 非0表示控制块由调用者提供
+ */
+static void semaphoreInit(Semaphore_t *semaphore, uint32_t maxCount, uint32_t initialCount, uint8_t isStatic) {
+    semaphore->count = initialCount;
+    semaphore->maxCount = maxCount;
+    eventListInit(&semaphore->eventList);
+    semaphore->watchers = NULL;
+    semaphore->isStatic = isStatic;
+}
+
+#if SYNC_FAST_PATH == 1
+/**
+ * @brief 快速路径: 计数大于0时用独占访问指令减一, 不进入临界区
+ * @return 成功获取返回1, 计数为0返回0 (交给临界区路径处理)
+ */
+static inline int semaphoreTryTakeFast(Semaphore_t *semaphore) {
+    uint32_t count;
+    do {
+        count = MyRTOS_Port_LoadExclusive(&semaphore->count);
+        if (count == 0) {
+            MyRTOS_Port_ClearExclusive();
+            return 0;
+        }
+    } while (MyRTOS_Port_StoreExclusive(&semaphore->count, count - 1) != 0);
+    return 1;
+}
+
+/**
+ * @brief 快速路径: 没有等待者和观察者且未达最大值时用独占访问指令加一, 不进入临界区
+ * @note  等待列表和观察者链表在 LDREX 之后检查: 新的等待者或观察者只能在一次任务切换之后出现,
+ *        切换会使 STREX 失败, 重试时即可看到它们并转入临界区路径, 不会丢失唤醒。
+ * @return 成功释放返回1, 需要临界区路径处理返回0
+ */
+static inline int semaphoreTryGiveFast(Semaphore_t *semaphore) {
+    uint32_t count;
+    do {
+        count = MyRTOS_Port_LoadExclusive(&semaphore->count);
+        if (count >= semaphore->maxCount || semaphore->eventList.head != NULL || semaphore->watchers != NULL) {
+            MyRTOS_Port_ClearExclusive();
+            return 0;
+        }
+    } while (MyRTOS_Port_StoreExclusive(&semaphore->count, count + 1) != 0);
+    return 1;
+}
+#endif
 
 /*===========================================================================*
  * 公开接口实现
  *===========================================================================*/
 
+#if MYRTOS_USE_HEAP == 1
 /**
  * @brief 创建一个计数信号量
  * @param maxCount 信号量的最大计数值
@@ -26,15 +78,31 @@ SemaphoreHandle_t Semaphore_Create(uint32_t maxCount, uint32_t initialCount) {
         return NULL;
     Semaphore_t *semaphore = MyRTOS_Malloc(sizeof(Semaphore_t));
     if (semaphore != NULL) {
-        semaphore->count = initialCount;
-        semaphore->maxCount = maxCount;
-        eventListInit(&semaphore->eventList);
+        semaphoreInit(semaphore, maxCount, initialCount, 0);
     }
     return semaphore;
 }
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块创建一个计数信号量
+ * @param maxCount 信号量的最大计数值
+ * @param initialCount 信号量的初始计数值
+ * @param semaphore_buffer 信号量控制块存储
+ * @return 成功则返回信号量句柄，失败则返回NULL
+ */
+SemaphoreHandle_t Semaphore_CreateStatic(uint32_t maxCount, uint32_t initialCount,
+                                         StaticSemaphore_t *semaphore_buffer) {
+    if (maxCount == 0 || initialCount > maxCount || semaphore_buffer == NULL)
+        return NULL;
+    Semaphore_t *semaphore = (Semaphore_t *) semaphore_buffer;
+    semaphoreInit(semaphore, maxCount, initialCount, 1);
+    return semaphore;
+}
 
 /**
  * @brief 删除一个信号量
+ * @note  会唤醒所有等待该信号量的任务, 并通知所有观察者。
  * @param semaphore 要删除的信号量句柄
  */
 void Semaphore_Delete(SemaphoreHandle_t semaphore) {
@@ -47,8 +115,32 @@ void Semaphore_Delete(SemaphoreHandle_t semaphore) {
         eventListRemove(taskToWake);
         addTaskToReadyList(taskToWake);
     }
-    MyRTOS_Free(semaphore);
+    objectWatchNotify(&semaphore->watchers);
+#if MYRTOS_USE_HEAP == 1
+    if (!semaphore->isStatic) {
+        MyRTOS_Free(semaphore);
+    }
+#endif
+    MyRTOS_Port_ExitCritical();
+}
+
+/**
+ * @brief 设置信号量等待队列的排队顺序
+ * @param semaphore 信号量句柄
+ * @param order 排队顺序
+ * @return 成功返回0，句柄无效或已有任务在等待返回-1
+ */
+int Semaphore_SetWaitOrder(SemaphoreHandle_t semaphore, WaitOrder_t order) {
+    if (semaphore == NULL)
+        return -1;
+    int result = -1;
+    MyRTOS_Port_EnterCritical();
+    if (semaphore->eventList.head == NULL) {
+        eventListSetFifo(&semaphore->eventList, order == WAIT_ORDER_FIFO);
+        result = 0;
+    }
     MyRTOS_Port_ExitCritical();
+    return result;
 }
 
 /**
@@ -60,6 +152,10 @@ void Semaphore_Delete(SemaphoreHandle_t semaphore) {
 int Semaphore_Take(SemaphoreHandle_t semaphore, uint32_t block_ticks) {
     if (semaphore == NULL)
         return 0;
+#if SYNC_FAST_PATH == 1
+    if (semaphoreTryTakeFast(semaphore))
+        return 1;
+#endif
     while (1) {
         MyRTOS_Port_EnterCritical();
         // 情况1: 信号量计数大于0，成功获取
@@ -80,7 +176,7 @@ int Semaphore_Take(SemaphoreHandle_t semaphore, uint32_t block_ticks) {
         currentTask->delay = 0;
         if (block_ticks != MYRTOS_MAX_DELAY) {
             currentTask->delay = MyRTOS_GetTick() + block_ticks;
-            addTaskToSortedDelayList(currentTask);
+            addTaskToDelayList(currentTask);
         }
         MyRTOS_Port_ExitCritical();
         MyRTOS_Port_Yield(); // 触发调度，进入阻塞
@@ -103,6 +199,10 @@ int Semaphore_Take(SemaphoreHandle_t semaphore, uint32_t block_ticks) {
 int Semaphore_Give(SemaphoreHandle_t semaphore) {
     if (semaphore == NULL)
         return 0;
+#if SYNC_FAST_PATH == 1
+    if (semaphoreTryGiveFast(semaphore))
+        return 1;
+#endif
     int trigger_yield = 0;
     MyRTOS_Port_EnterCritical();
     // 如果有任务在等待信号量，则直接唤醒一个，而不增加计数值
@@ -110,16 +210,18 @@ int Semaphore_Give(SemaphoreHandle_t semaphore) {
         Task_t *taskToWake = semaphore->eventList.head;
         eventListRemove(taskToWake);
         if (taskToWake->delay > 0) {
-            removeTaskFromList(get_delayed_task_list_head(), taskToWake);
+            removeTaskFromDelayList(taskToWake);
             taskToWake->delay = 0;
         }
         addTaskToReadyList(taskToWake);
-        if (taskToWake->priority > currentTask->priority)
+        if (scheduler_task_preempts_current(taskToWake))
             trigger_yield = 1;
     } else {
         // 如果没有任务等待，则增加计数值
         if (semaphore->count < semaphore->maxCount) {
             semaphore->count++;
+            if (semaphore->watchers != NULL && objectWatchNotify(&semaphore->watchers))
+                trigger_yield = 1;
         } else {
             // 已达最大值，释放失败
             MyRTOS_Port_ExitCritical();
@@ -149,20 +251,41 @@ int Semaphore_GiveFromISR(SemaphoreHandle_t semaphore, int *pxHigherPriorityTask
         Task_t *taskToWake = semaphore->eventList.head;
         eventListRemove(taskToWake);
         if (taskToWake->delay > 0) {
-            removeTaskFromList(get_delayed_task_list_head(), taskToWake);
+            removeTaskFromDelayList(taskToWake);
             taskToWake->delay = 0;
         }
         addTaskToReadyList(taskToWake);
-        if (taskToWake->priority > currentTask->priority) {
+        if (scheduler_task_preempts_current(taskToWake)) {
             *pxHigherPriorityTaskWoken = 1;
         }
         result = 1;
     } else {
         if (semaphore->count < semaphore->maxCount) {
             semaphore->count++;
+            if (semaphore->watchers != NULL && objectWatchNotify(&semaphore->watchers))
+                *pxHigherPriorityTaskWoken = 1;
             result = 1;
         }
     }
     MyRTOS_Port_ExitCritical();
     return result;
 }
+
+/**
+ * @brief 在信号量上挂载观察者
+ * @param semaphore 目标信号量句柄
+ * @param watch 观察者
+ * @return 已挂载返回0，信号量计数大于0返回1，参数无效返回-1
+ */
+int Semaphore_Watch(SemaphoreHandle_t semaphore, ObjectWatch_t *watch) {
+    if (semaphore == NULL || watch == NULL || watch->task == NULL)
+        return -1;
+    int result = 1;
+    MyRTOS_Port_EnterCritical();
+    if (semaphore->count == 0) {
+        objectWatchAttach(&semaphore->watchers, watch);
+        result = 0;
+    }
+    MyRTOS_Port_ExitCritical();
+    return result;
+}
@@ -8,8 +8,7 @@
 /*===========================================================================*
  * 外部函数声明
  *===========================================================================*/
-extern TaskHandle_t *get_delayed_task_list_head(void);
-extern TaskHandle_t *get_ready_task_list(uint8_t priority);
+extern TaskList_t *get_ready_task_list(uint8_t priority);
 
 /*===========================================================================*
  * 内部函数实现
@@ -30,6 +29,62 @@ int check_signal_wait_condition(TaskHandle_t task) {
     }
 }
 
+/**
+ * @brief 向任务发送信号, 条件满足时唤醒正在等待信号的任务
+ * @note  必须在临界区中调用, 不触发调度。Task_SendSignal、Task_SendSignalFromISR 与对象观察者共用。
+ * @return 被唤醒的任务需要抢占当前任务时返回1
+ */
+int signalSendLocked(TaskHandle_t task, uint32_t signals) {
+    // 原子地设置目标任务的待处理信号
+    task->signals_pending |= signals;
+
+    //检查目标任务是否正在等待信号 (通过检查其pEventList是否指向自己的signal_event_list)
+    // 已超时的等待者已在就绪链表中, 由它自己离开事件列表, 信号留待下次等待
+    if (task->pEventList != &task->signal_event_list || task->state != TASK_STATE_BLOCKED ||
+        !check_signal_wait_condition(task)) {
+        return 0;
+    }
+    //从它自己的事件列表中移除 (这会将其pEventList设为NULL)
+    eventListRemove(task);
+    // 如果任务因超时也存在于延迟列表中，则一并移除
+    if (task->delay > 0) {
+        removeTaskFromDelayList(task);
+        task->delay = 0;
+    }
+    addTaskToReadyList(task);
+    return scheduler_task_preempts_current(task);
+}
+
+/**
+ * @brief 把观察者挂到内核对象的观察者链表上
+ * @note  必须在临界区中调用。
+ */
+void objectWatchAttach(ObjectWatch_t **list, ObjectWatch_t *watch) {
+    watch->next = *list;
+    watch->pList = list;
+    *list = watch;
+}
+
+/**
+ * @brief 内核对象变为可用, 摘下所有观察者并向它们的任务发送信号
+ * @note  必须在临界区中调用, 不触发调度。临界区长度与观察者数量成正比。
+ * @return 有被唤醒的任务需要抢占当前任务时返回1
+ */
+int objectWatchNotify(ObjectWatch_t **list) {
+    int preempt = 0;
+    ObjectWatch_t *watch = *list;
+    *list = NULL;
+    while (watch != NULL) {
+        ObjectWatch_t *next = watch->next;
+        watch->next = NULL;
+        watch->pList = NULL;
+        if (signalSendLocked(watch->task, watch->signal))
+            preempt = 1;
+        watch = next;
+    }
+    return preempt;
+}
+
 /*===========================================================================*
  * 公开接口实现
  *===========================================================================*/
@@ -39,33 +94,8 @@ int Task_SendSignal(TaskHandle_t target_task, uint32_t signals) {
         return -1;
     }
 
-    Task_t *pTargetTask = (Task_t *) target_task;
-    int trigger_yield = 0;
-
-    MyRTOS_Port_EnterCritical(); {
-        // 原子地设置目标任务的待处理信号
-        pTargetTask->signals_pending |= signals;
-
-        //检查目标任务是否正在等待信号 (通过检查其pEventList是否指向自己的signal_event_list)
-        if (pTargetTask->pEventList == &pTargetTask->signal_event_list) {
-            //检查唤醒条件是否满足
-            if (check_signal_wait_condition(pTargetTask)) {
-                //唤醒任务
-                //从它自己的事件列表中移除 (这会将其pEventList设为NULL)
-                eventListRemove(pTargetTask);
-                // 如果任务因超时也存在于延迟列表中，则一并移除
-                if (pTargetTask->delay > 0) {
-                    removeTaskFromList(get_delayed_task_list_head(), pTargetTask);
-                    pTargetTask->delay = 0;
-                }
-                addTaskToReadyList(pTargetTask);
-                // 检查是否需要调度
-                if (pTargetTask->priority > currentTask->priority) {
-                    trigger_yield = 1;
-                }
-            }
-        }
-    }
+    MyRTOS_Port_EnterCritical();
+    const int trigger_yield = signalSendLocked(target_task, signals);
     MyRTOS_Port_ExitCritical();
 
     if (trigger_yield) {
@@ -80,27 +110,8 @@ int Task_SendSignalFromISR(TaskHandle_t target_task, uint32_t signals, int *high
         return -1;
     }
 
-    Task_t *pTargetTask = (Task_t *) target_task;
-    *higherPriorityTaskWoken = 0;
-
-    MyRTOS_Port_EnterCritical(); {
-        pTargetTask->signals_pending |= signals;
-
-        if (pTargetTask->pEventList == &pTargetTask->signal_event_list) {
-            if (check_signal_wait_condition(pTargetTask)) {
-                eventListRemove(pTargetTask);
-                if (pTargetTask->delay > 0) {
-                    removeTaskFromList(get_delayed_task_list_head(), pTargetTask);
-                    pTargetTask->delay = 0;
-                }
-                addTaskToReadyList(pTargetTask);
-
-                if (pTargetTask->priority > currentTask->priority) {
-                    *higherPriorityTaskWoken = 1;
-                }
-            }
-        }
-    }
+    MyRTOS_Port_EnterCritical();
+    *higherPriorityTaskWoken = signalSendLocked(target_task, signals);
     MyRTOS_Port_ExitCritical();
 
     return 0;
@@ -153,7 +164,7 @@ uint32_t Task_WaitSignal(uint32_t signal_mask, uint32_t block_ticks, uint32_t op
         //处理超时
         if (block_ticks != MYRTOS_MAX_DELAY) {
             currentTask->delay = MyRTOS_GetTick() + block_ticks;
-            addTaskToSortedDelayList(currentTask);
+            addTaskToDelayList(currentTask);
         }
     }
     MyRTOS_Port_ExitCritical();
@@ -200,3 +211,22 @@ int Task_ClearSignal(TaskHandle_t task_to_clear, uint32_t signals_to_clear) {
 
     return 0;
 }
+
+void ObjectWatch_Cancel(ObjectWatch_t *watch) {
+    if (watch == NULL) {
+        return;
+    }
+    MyRTOS_Port_EnterCritical();
+    ObjectWatch_t **link = watch->pList;
+    if (link != NULL) {
+        while (*link != NULL && *link != watch) {
+            link = &(*link)->next;
+        }
+        if (*link == watch) {
+            *link = watch->next;
+        }
+        watch->next = NULL;
+        watch->pList = NULL;
+    }
+    MyRTOS_Port_ExitCritical();
+}
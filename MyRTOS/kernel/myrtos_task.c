@@ -9,35 +9,65 @@
  * 外部函数声明
  *===========================================================================*/
 extern void task_set_priority(TaskHandle_t task, uint8_t newPriority);
-extern TaskHandle_t *get_delayed_task_list_head(void);
-extern TaskHandle_t *get_ready_task_list(uint8_t priority);
+extern TaskList_t *get_ready_task_list(uint8_t priority);
 
 /*===========================================================================*
  * 私有变量
  *===========================================================================*/
 
-// 用于分配下一个任务ID的计数器
-static uint32_t nextTaskId = 0;
-// 任务ID的位图，用于快速查找可用的ID
-static uint64_t taskIdBitmap = 0;
+// 任务槽位表, 以任务ID为下标, 使 ID 到 TCB 的查找为 O(1)
+static Task_t *taskSlotTable[MYRTOS_MAX_CONCURRENT_TASKS];
+// 每个槽位的代数, 槽位每回收一次加一, 用于识别过期的任务引用
+static uint16_t taskSlotGeneration[MYRTOS_MAX_CONCURRENT_TASKS];
+// 已回收的空闲任务ID栈
+static uint16_t taskFreeIdStack[MYRTOS_MAX_CONCURRENT_TASKS];
+static uint32_t taskFreeIdCount = 0;
+// 从未被使用过的最小任务ID, 空闲栈为空时从这里分配
+static uint32_t taskNextFreshId = 0;
+
+/*===========================================================================*
+ * 私有宏定义
+ *===========================================================================*/
+
+// 任务内存块内各部分的对齐
+#define TASK_BLOCK_ALIGN(size) \
+    (((size) + (MYRTOS_HEAP_BYTE_ALIGNMENT - 1)) & ~((size_t) MYRTOS_HEAP_BYTE_ALIGNMENT - 1))
 
 /*===========================================================================*
  * 私有函数
  *===========================================================================*/
 
+/**
+ * @brief 未提供任务名时使用的默认名字
+ */
+static inline const char *taskNameOrDefault(const char *taskName) {
+    return (taskName != NULL && *taskName != '\0') ? taskName : "Unnamed";
+}
+
+/**
+ * @brief 判断字符串是否位于只读存储 (MYRTOS_ROM_START ~ MYRTOS_ROM_END) 中
+ * @note  只读存储中的字符串在整个运行期间都有效, 可以直接引用而不必复制。
+ *        未配置只读存储范围时总是返回0。
+ */
+static inline int taskNameIsConst(const char *name) {
+#if MYRTOS_ROM_END > MYRTOS_ROM_START
+    // 无符号回绕使一次比较同时检查上下界
+    return ((uintptr_t) name - MYRTOS_ROM_START) < (MYRTOS_ROM_END - MYRTOS_ROM_START);
+#else
+    (void) name;
+    return 0;
+#endif
+}
+
 /**
  * @brief 所有任务的实际入口包装函数
  * @note  如果任务函数返回了,这里可以兜底, 防止系统崩溃
- * @param parameters  指向TaskEntryPoint_t的指针
- */
-static void taskWrapper(void *wrapperPrameters) {
-    TaskEntryPoint_t *entry = (TaskEntryPoint_t *) wrapperPrameters;
-    // 从结构体中提取出真正的用户函数和参数
-    void (*taskFunc)(void *) = entry->taskFunc;
-    void *parameters = entry->parameters;
-    MyRTOS_Free(entry);
+ * @param wrapperParameters 任务自身的TCB, 用户函数和参数直接从TCB中取得, 无需额外分配
+ */
+static void taskWrapper(void *wrapperParameters) {
+    Task_t *self = (Task_t *) wrapperParameters;
     // 调用真正的用户任务函数
-    taskFunc(parameters);
+    self->func(self->param);
     // 如果用户任务函数执行到这,捕获它,并调用 Task_Delete 来删除
     //NULL 表示删除当前正在运行的任务
     KernelEventData_t eventData = {.eventType = KERNEL_EVENT_ERROR_TASK_RETURN, .task = currentTask};
@@ -46,56 +76,77 @@ static void taskWrapper(void *wrapperPrameters) {
     while (1); // 永远不会执行
 }
 
+/**
+ * @brief 分配一个任务ID并占用对应槽位, O(1)
+ * @note  调用者必须处于临界区内。优先复用已回收的ID, 否则取一个全新的ID。
+ * @param task 占用该槽位的任务
+ * @return 成功返回任务ID, 槽位耗尽返回 (uint32_t)-1
+ */
+static uint32_t taskIdAlloc(Task_t *task) {
+    uint32_t id;
+    if (taskFreeIdCount > 0) {
+        id = taskFreeIdStack[--taskFreeIdCount];
+    } else if (taskNextFreshId < MYRTOS_MAX_CONCURRENT_TASKS) {
+        id = taskNextFreshId++;
+    } else {
+        return (uint32_t) -1;
+    }
+    taskSlotTable[id] = task;
+    return id;
+}
+
+/**
+ * @brief 释放任务ID, O(1)
+ * @note  调用者必须处于临界区内。槽位代数加一, 使指向旧任务的 TaskRef_t 失效。
+ * @param id 要释放的任务ID
+ */
+static void taskIdFree(uint32_t id) {
+    taskSlotTable[id] = NULL;
+    taskSlotGeneration[id]++;
+    taskFreeIdStack[taskFreeIdCount++] = (uint16_t) id;
+}
+
 /*===========================================================================*
- * 公开接口实现
+ * 内部接口实现
  *===========================================================================*/
 
 /**
- * @brief 创建一个新任务
- * @param func 任务函数指针
- * @param taskName 任务名称-字符串
- * @param stack_size 任务堆栈大小（以StackType_t为单位，通常是4字节）
- * @param param 传递给任务函数的参数
- * @param priority 任务优先级 (0是最低优先级)
- * @return 成功则返回任务句柄，失败则返回NULL
+ * @brief 初始化任务槽位表
+ * @note  由 MyRTOS_Init 调用。槽位代数不清零, 以免重新初始化后旧引用被误判为有效。
  */
-TaskHandle_t Task_Create(void (*func)(void *), const char *taskName, uint16_t stack_size, void *param,
-                         uint8_t priority) {
-    if (priority >= MYRTOS_MAX_PRIORITIES || func == NULL)
-        return NULL;
-    // 为任务控制块（TCB）分配内存
-    Task_t *t = MyRTOS_Malloc(sizeof(Task_t));
-    if (t == NULL)
-        return NULL;
-    // 为任务堆栈分配内存
-    StackType_t *stack = MyRTOS_Malloc(stack_size * sizeof(StackType_t));
-    if (stack == NULL) {
-        MyRTOS_Free(t);
-        return NULL;
+void task_slots_init(void) {
+    for (uint32_t i = 0; i < MYRTOS_MAX_CONCURRENT_TASKS; i++) {
+        taskSlotTable[i] = NULL;
     }
+    taskFreeIdCount = 0;
+    taskNextFreshId = 0;
+}
 
-    TaskEntryPoint_t *entry = MyRTOS_Malloc(sizeof(TaskEntryPoint_t));
-    if (entry == NULL) {
-        MyRTOS_Free(stack);
-        MyRTOS_Free(t);
-        return NULL;
-    }
-    // 填充
-    entry->taskFunc = func;
-    entry->parameters = param;
+/*===========================================================================*
+ * 公开接口实现
+ *===========================================================================*/
 
+/**
+ * @brief 在已分配好的TCB和栈上初始化任务并加入就绪链表
+ * @param t 任务控制块
+ * @param stack 任务栈
+ * @param isStatic 非0表示TCB和栈由调用者提供
+ * @param taskName 任务名, 直接引用, 必须在任务生命周期内有效
+ * @param relative_deadline EDF相对截止时间(Tick), 0 表示普通的固定优先级任务
+ * @param period EDF周期(Tick)
+ * @note  其余参数同 Task_Create。任务在加入就绪链表前完成全部初始化, 包括EDF截止时间。
+ *        失败时不释放 t 和 stack, 由调用者处理。
+ * @return 成功返回任务句柄, 任务ID耗尽返回NULL
+ */
+static TaskHandle_t initialiseTask(Task_t *t, StackType_t *stack, uint8_t isStatic, void (*func)(void *),
+                                   const char *taskName, uint16_t stack_size, void *param, uint8_t priority,
+                                   uint32_t relative_deadline, uint32_t period) {
     // 分配一个唯一的任务ID
-    uint32_t newTaskId = (uint32_t) -1;
     MyRTOS_Port_EnterCritical();
-    if (taskIdBitmap != 0xFFFFFFFFFFFFFFFFULL) {
-        newTaskId = __builtin_ctzll(~taskIdBitmap); // 查找位图中第一个为0的位
-        taskIdBitmap |= (1ULL << newTaskId);
-    }
+    uint32_t newTaskId = taskIdAlloc(t);
     MyRTOS_Port_ExitCritical();
     if (newTaskId == (uint32_t) -1) {
         // 如果没有可用的任务ID
-        MyRTOS_Free(stack);
-        MyRTOS_Free(t);
         return NULL;
     }
     // 初始化任务控制块（TCB）
@@ -109,63 +160,69 @@ TaskHandle_t Task_Create(void (*func)(void *), const char *taskName, uint16_t st
     t->wait_options = 0;
     eventListInit(&t->signal_event_list);
     t->taskId = newTaskId;
+    t->taskGeneration = taskSlotGeneration[newTaskId];
     t->stack_base = stack;
     t->priority = priority;
     t->basePriority = priority;
+    t->preemptThreshold = priority;
+    t->timeSlice = MYRTOS_DEFAULT_TIME_SLICE;
+    t->timeSliceRemaining = MYRTOS_DEFAULT_TIME_SLICE;
+    t->releaseCount = 0;
+    t->releaseJitterMax = 0;
+    t->releaseJitterTotal = 0;
+    t->releaseOverruns = 0;
+    t->inheritBoosts = 0;
+#if MYRTOS_USE_EDF == 1
+    t->relativeDeadline = relative_deadline;
+    t->period = period;
+    t->deadlineMisses = 0;
+    t->releaseTime = MyRTOS_GetTick();
+    t->absDeadline = (relative_deadline != 0) ? t->releaseTime + relative_deadline : UINT64_MAX;
+    if (relative_deadline != 0) {
+        // EDF任务的顺序由截止时间决定, 不使用时间片
+        t->timeSlice = 0;
+        t->timeSliceRemaining = 0;
+    }
+#else
+    (void) relative_deadline;
+    (void) period;
+#endif
+#if MYRTOS_USE_BUDGET == 1
+    t->budgetPeriodEnd = 0;
+    t->budget = 0;
+    t->budgetPeriod = 0;
+    t->budgetUsed = 0;
+    t->budgetExhaustions = 0;
+#endif
     t->pNextTask = NULL;
+    t->pPrevTask = NULL;
     t->pNextGeneric = NULL;
     t->pPrevGeneric = NULL;
+    t->pDelayList = NULL;
     t->pNextEvent = NULL;
+    t->pPrevEvent = NULL;
     t->pEventList = NULL;
     t->held_mutexes_head = NULL;
+    t->blockedOnMutex = NULL;
     t->eventData = NULL;
-    char *name_buffer = NULL;
-    char default_name_temp[16];
-    if (taskName != NULL && *taskName != '\0') {
-        // 如果提供了有效的名字
-        size_t name_len = strlen(taskName) + 1;
-        name_buffer = MyRTOS_Malloc(name_len);
-        if (name_buffer != NULL) {
-            // 内存分配成功，复制名字
-            memcpy(name_buffer, taskName, name_len);
-        }
-    }
-
-    if (name_buffer == NULL) {
-        // 如果 (1) taskName是NULL (2) taskName是空字符串 (3) Malloc失败
-        // 我们都需要创建一个默认名字
-        snprintf(default_name_temp, sizeof(default_name_temp), "Unnamed_%lu", newTaskId);
-        // 为默认名字分配内存并复制
-        size_t default_len = strlen(default_name_temp) + 1;
-        name_buffer = MyRTOS_Malloc(default_len);
-        if (name_buffer != NULL) {
-            memcpy(name_buffer, default_name_temp, default_len);
-        } else {
-            MyRTOS_Free(stack);
-            MyRTOS_Free(t);
-            return NULL;
-        }
-    }
-    if (name_buffer != NULL) {
-        t->taskName = name_buffer;
-    }
+    t->isStatic = isStatic;
+    t->taskName = taskName;
     t->stackSize_words = stack_size;
-    // 使用魔法数字填充堆栈，用于堆栈溢出检测
-    for (uint16_t i = 0; i < stack_size; ++i) {
-        stack[i] = 0xA5A5A5A5;
-    }
-    // 调用移植层代码初始化任务堆栈（模拟CPU上下文）
-    t->sp = MyRTOS_Port_InitialiseStack(stack + stack_size, taskWrapper, entry);
+#if MYRTOS_TASK_STACK_PAINT == 1
+    // 使用魔法数字填充堆栈，用于统计栈的最大使用量
+    memset(stack, (int) (MYRTOS_STACK_PAINT_VALUE & 0xFF), stack_size * sizeof(StackType_t));
+#endif
+    // 调用移植层代码初始化任务堆栈（模拟CPU上下文）, 包装函数的参数是任务自身的TCB
+    t->sp = MyRTOS_Port_InitialiseStack(stack + stack_size, taskWrapper, t);
     MyRTOS_Port_EnterCritical(); {
-        // 将新任务添加到全局任务列表中
-        if (allTaskListHead == NULL) {
+        // 将新任务追加到全局任务列表末尾
+        t->pPrevTask = allTaskListTail;
+        if (allTaskListTail == NULL) {
             allTaskListHead = t;
         } else {
-            Task_t *p = allTaskListHead;
-            while (p->pNextTask != NULL)
-                p = p->pNextTask;
-            p->pNextTask = t;
+            allTaskListTail->pNextTask = t;
         }
+        allTaskListTail = t;
         // 将新任务添加到就绪列表
         addTaskToReadyList(t);
     }
@@ -176,6 +233,95 @@ TaskHandle_t Task_Create(void (*func)(void *), const char *taskName, uint16_t st
     return t;
 }
 
+#if MYRTOS_USE_HEAP == 1
+/**
+ * @brief 从内存堆中分配任务并创建
+ * @param relative_deadline EDF相对截止时间(Tick), 0 表示普通的固定优先级任务
+ * @param period EDF周期(Tick)
+ * @note  其余参数同 Task_Create。栈、TCB和任务名副本在同一次分配中连续存放:
+ *        [栈][TCB][任务名], 栈向下溢出时先破坏前面的堆块头而不是自己的TCB。
+ *        删除任务时只需释放栈基地址这一块内存。
+ */
+static TaskHandle_t createTask(void (*func)(void *), const char *taskName, uint16_t stack_size, void *param,
+                               uint8_t priority, uint32_t relative_deadline, uint32_t period) {
+    if (PRIORITY_OUT_OF_RANGE(priority) || func == NULL)
+        return NULL;
+    const char *name = taskNameOrDefault(taskName);
+    // 只读存储中的任务名直接引用, 其余的复制到任务自己的内存块中
+    const size_t nameCopyLen = taskNameIsConst(name) ? 0 : strlen(name) + 1;
+    const size_t stackBytes = TASK_BLOCK_ALIGN(stack_size * sizeof(StackType_t));
+    const size_t tcbBytes = TASK_BLOCK_ALIGN(sizeof(Task_t));
+    uint8_t *block = MyRTOS_Malloc(stackBytes + tcbBytes + nameCopyLen);
+    if (block == NULL)
+        return NULL;
+    StackType_t *stack = (StackType_t *) block;
+    Task_t *t = (Task_t *) (block + stackBytes);
+    if (nameCopyLen != 0) {
+        char *nameCopy = (char *) (block + stackBytes + tcbBytes);
+        memcpy(nameCopy, name, nameCopyLen);
+        name = nameCopy;
+    }
+    TaskHandle_t handle =
+            initialiseTask(t, stack, 0, func, name, stack_size, param, priority, relative_deadline, period);
+    if (handle == NULL) {
+        MyRTOS_Free(block);
+    }
+    return handle;
+}
+
+/**
+ * @brief 创建一个新任务
+ * @param func 任务函数指针
+ * @param taskName 任务名称-字符串
+ * @param stack_size 任务堆栈大小（以StackType_t为单位，通常是4字节）
+ * @param param 传递给任务函数的参数
+ * @param priority 任务优先级 (0是最低优先级)
+ * @return 成功则返回任务句柄，失败则返回NULL
+ */
+TaskHandle_t Task_Create(void (*func)(void *), const char *taskName, uint16_t stack_size, void *param,
+                         uint8_t priority) {
+    return createTask(func, taskName, stack_size, param, priority, 0, 0);
+}
+#endif
+
+/**
+ * @brief 使用调用者提供的TCB和栈创建一个新任务
+ * @param func 任务函数指针
+ * @param taskName 任务名称-字符串, 不复制, 必须在任务生命周期内有效
+ * @param stack_size 任务堆栈大小（以StackType_t为单位）
+ * @param param 传递给任务函数的参数
+ * @param priority 任务优先级 (0是最低优先级)
+ * @param stack_buffer 任务栈, 至少 stack_size 个 StackType_t
+ * @param tcb_buffer 任务控制块存储
+ * @return 成功则返回任务句柄，失败则返回NULL
+ */
+TaskHandle_t Task_CreateStatic(void (*func)(void *), const char *taskName, uint16_t stack_size, void *param,
+                               uint8_t priority, void *stack_buffer, StaticTask_t *tcb_buffer) {
+    if (PRIORITY_OUT_OF_RANGE(priority) || func == NULL || stack_buffer == NULL || tcb_buffer == NULL)
+        return NULL;
+    return initialiseTask((Task_t *) tcb_buffer, (StackType_t *) stack_buffer, 1, func, taskNameOrDefault(taskName),
+                          stack_size, param, priority, 0, 0);
+}
+
+#if MYRTOS_USE_EDF == 1 && MYRTOS_USE_HEAP == 1
+/**
+ * @brief 创建一个EDF调度类的周期任务
+ * @param func 任务函数指针
+ * @param taskName 任务名称-字符串
+ * @param stack_size 任务堆栈大小（以StackType_t为单位）
+ * @param param 传递给任务函数的参数
+ * @param relative_deadline 相对截止时间(Tick)
+ * @param period 周期(Tick)
+ * @return 成功则返回任务句柄，失败则返回NULL
+ */
+TaskHandle_t Task_CreateEDF(void (*func)(void *), const char *taskName, uint16_t stack_size, void *param,
+                            uint32_t relative_deadline, uint32_t period) {
+    if (relative_deadline == 0 || period == 0)
+        return NULL;
+    return createTask(func, taskName, stack_size, param, MYRTOS_EDF_PRIORITY, relative_deadline, period);
+}
+#endif
+
 /**
  * @brief 删除一个任务
  * @param task_h 要删除的任务句柄。如果为NULL，则删除当前任务。
@@ -190,16 +336,19 @@ int Task_Delete(TaskHandle_t task_h) {
     // 广播任务删除事件
     KernelEventData_t eventData = {.eventType = KERNEL_EVENT_TASK_DELETE, .task = task_to_delete};
     broadcast_event(&eventData);
+    // 释放内存时会遍历空闲链表, 整个删除过程锁定调度器, 只有操作中断也会访问的链表时才关中断
+    MyRTOS_Schedule_Lock();
     MyRTOS_Port_EnterCritical();
     // 从其所在的任何链表中移除任务
     if (task_to_delete->state == TASK_STATE_READY) {
         removeTaskFromList(get_ready_task_list(task_to_delete->priority), task_to_delete);
     } else if (task_to_delete->state == TASK_STATE_DELAYED || task_to_delete->state == TASK_STATE_BLOCKED) {
         if(task_to_delete->delay > 0) {
-            removeTaskFromList(get_delayed_task_list_head(), task_to_delete);
+            removeTaskFromDelayList(task_to_delete);
         }
         if(task_to_delete->pEventList != NULL) {
             eventListRemove(task_to_delete);
+            mutexWaitAborted(task_to_delete);
         }
     }
     // 释放任务持有的所有互斥锁
@@ -208,36 +357,34 @@ int Task_Delete(TaskHandle_t task_h) {
     }
     task_to_delete->state = TASK_STATE_UNUSED;
     // 从全局任务列表中移除
-    Task_t *prev = NULL, *curr = allTaskListHead;
-    while (curr != NULL && curr != task_to_delete) {
-        prev = curr;
-        curr = curr->pNextTask;
+    if (task_to_delete->pPrevTask != NULL) {
+        task_to_delete->pPrevTask->pNextTask = task_to_delete->pNextTask;
+    } else {
+        allTaskListHead = task_to_delete->pNextTask;
     }
-    if (curr != NULL) {
-        if (prev == NULL)
-            allTaskListHead = curr->pNextTask;
-        else
-            prev->pNextTask = curr->pNextTask;
+    if (task_to_delete->pNextTask != NULL) {
+        task_to_delete->pNextTask->pPrevTask = task_to_delete->pPrevTask;
+    } else {
+        allTaskListTail = task_to_delete->pPrevTask;
     }
-    void *stack_to_free = task_to_delete->stack_base;
-    if (task_to_delete->taskName != NULL) {
-        MyRTOS_Free((void *) task_to_delete->taskName);
+    taskIdFree(deleted_task_id); // 回收任务ID
+    MyRTOS_Port_ExitCritical();
+#if MYRTOS_USE_HEAP == 1
+    // 动态任务的栈、TCB和任务名位于以栈基地址开始的同一块内存中; 静态任务的存储属于调用者
+    if (!task_to_delete->isStatic) {
+        MyRTOS_Free(task_to_delete->stack_base);
     }
+#endif
     // 如果是删除自身
     if (task_h == NULL) {
+        MyRTOS_Port_EnterCritical();
         currentTask = NULL; // 标记当前任务为空，调度器将选择新任务
-        taskIdBitmap &= ~(1ULL << deleted_task_id); // 回收任务ID
-        MyRTOS_Free(task_to_delete);
-        MyRTOS_Free(stack_to_free);
+        MyRTOS_Schedule_Unlock();
         MyRTOS_Port_ExitCritical();
         MyRTOS_Port_Yield(); // 触发调度，此任务将不再执行
     } else {
         // 如果是删除其他任务
-        taskIdBitmap &= ~(1ULL << deleted_task_id); // 回收任务ID
-        MyRTOS_Free(task_to_delete);
-        MyRTOS_Free(stack_to_free);
-        MyRTOS_Port_ExitCritical();
-        // MyRTOS_Port_Yield();
+        MyRTOS_Schedule_Unlock();
     }
     return 0;
 }
@@ -256,12 +403,169 @@ void Task_Delay(uint32_t tick) {
         currentTask->delay = MyRTOS_GetTick() + tick;
         currentTask->state = TASK_STATE_DELAYED;
         // 将任务添加到排序的延迟链表中
-        addTaskToSortedDelayList(currentTask);
+        addTaskToDelayList(currentTask);
+    }
+    MyRTOS_Port_ExitCritical();
+    // 触发调度
+    MyRTOS_Port_Yield();
+}
+
+/**
+ * @brief 将当前任务延迟到下一个周期释放点
+ * @note  唤醒时间直接使用绝对的释放点, 延迟时间轮按绝对时间排队, 不会累积漂移。
+ *        释放抖动在任务重新运行时测量, 包含了唤醒后等待更高优先级任务的时间。
+ * @param previous_wake [in,out] 上一个释放点, 返回时更新为本次释放点
+ * @param period 周期(Tick)
+ * @return 跳过的释放点个数, 0 表示按时释放
+ */
+uint32_t Task_DelayUntil(uint64_t *previous_wake, uint32_t period) {
+    if (previous_wake == NULL || period == 0 || g_scheduler_started == 0)
+        return 0;
+    uint32_t missed = 0;
+    uint64_t release = *previous_wake + period;
+    MyRTOS_Port_EnterCritical(); {
+        const uint64_t now = MyRTOS_GetTick();
+        if (release <= now) {
+            // 超期: 不阻塞, 跳过已经错过的释放点并保持原来的周期相位
+            missed = (uint32_t) ((now - release) / period) + 1;
+            release += (uint64_t) (missed - 1) * period;
+            currentTask->releaseOverruns++;
+        } else {
+            removeTaskFromList(get_ready_task_list(currentTask->priority), currentTask);
+            currentTask->delay = release;
+            currentTask->state = TASK_STATE_DELAYED;
+            addTaskToDelayList(currentTask);
+        }
+    }
+    MyRTOS_Port_ExitCritical();
+    *previous_wake = release;
+    if (missed != 0) {
+        return missed;
+    }
+    // 触发调度, 返回时已经到达释放点
+    MyRTOS_Port_Yield();
+    const uint64_t jitter = MyRTOS_GetTick() - release;
+    const uint32_t jitter32 = (jitter > UINT32_MAX) ? UINT32_MAX : (uint32_t) jitter;
+    MyRTOS_Port_EnterCritical();
+    currentTask->releaseCount++;
+    currentTask->releaseJitterTotal += jitter32;
+    if (jitter32 > currentTask->releaseJitterMax) {
+        currentTask->releaseJitterMax = jitter32;
+    }
+    MyRTOS_Port_ExitCritical();
+    return 0;
+}
+
+/**
+ * @brief 当前任务主动让出CPU
+ * @note  当前任务被移动到同优先级就绪链表的末尾, 让同优先级的其他任务先运行。
+ */
+void Task_Yield(void) {
+    if (g_scheduler_started == 0)
+        return;
+    MyRTOS_Port_EnterCritical();
+    readyListRotate(currentTask);
+    MyRTOS_Port_ExitCritical();
+    MyRTOS_Port_Yield();
+}
+
+#if MYRTOS_USE_EDF == 1
+/**
+ * @brief 结束EDF任务的当前作业并等待下一个周期
+ */
+void Task_WaitForNextPeriod(void) {
+    if (g_scheduler_started == 0 || currentTask->relativeDeadline == 0)
+        return;
+    MyRTOS_Port_EnterCritical(); {
+        Task_t *task = currentTask;
+        const uint64_t now = MyRTOS_GetTick();
+        if (now > task->absDeadline) {
+            task->deadlineMisses++;
+        }
+        // 计算下一个释放点, 跳过已经错过的周期
+        task->releaseTime += task->period;
+        if (task->releaseTime < now) {
+            task->releaseTime += ((now - task->releaseTime) / task->period) * task->period;
+        }
+        task->absDeadline = task->releaseTime + task->relativeDeadline;
+        // 先移出就绪链表: 截止时间变了, 需要按新的截止时间重新排队
+        removeTaskFromList(get_ready_task_list(task->priority), task);
+        if (task->releaseTime > now) {
+            task->delay = task->releaseTime;
+            task->state = TASK_STATE_DELAYED;
+            addTaskToDelayList(task);
+        } else {
+            addTaskToReadyList(task);
+        }
     }
     MyRTOS_Port_ExitCritical();
     // 触发调度
     MyRTOS_Port_Yield();
 }
+#endif
+
+/**
+ * @brief 设置任务的时间片长度
+ * @param task_h 目标任务句柄, NULL 表示当前任务
+ * @param ticks 时间片长度(Tick), 0 表示不参与同优先级轮转
+ */
+void Task_SetTimeSlice(TaskHandle_t task_h, uint32_t ticks) {
+    Task_t *task = (task_h == NULL) ? currentTask : task_h;
+    if (task == NULL)
+        return;
+    MyRTOS_Port_EnterCritical();
+    task->timeSlice = ticks;
+    task->timeSliceRemaining = ticks;
+    MyRTOS_Port_ExitCritical();
+}
+
+/**
+ * @brief 设置任务的抢占阈值
+ * @note  降低当前任务的阈值时, 之前被阈值挡住的就绪任务可能需要立即运行, 因此触发一次调度。
+ * @param task_h 目标任务句柄, NULL 表示当前任务
+ * @param threshold 抢占阈值, 不能低于任务的基础优先级
+ * @return 成功返回0，参数无效返回-1
+ */
+int Task_SetPreemptionThreshold(TaskHandle_t task_h, uint8_t threshold) {
+    Task_t *task = (task_h == NULL) ? currentTask : task_h;
+    if (task == NULL || PRIORITY_OUT_OF_RANGE(threshold) || threshold < task->basePriority)
+        return -1;
+    int trigger_yield = 0;
+    MyRTOS_Port_EnterCritical();
+    if (task == currentTask && threshold < task->preemptThreshold) {
+        trigger_yield = 1;
+    }
+    task->preemptThreshold = threshold;
+    MyRTOS_Port_ExitCritical();
+    if (trigger_yield && g_scheduler_started) {
+        MyRTOS_Port_Yield();
+    }
+    return 0;
+}
+
+#if MYRTOS_USE_BUDGET == 1
+/**
+ * @brief 为任务设置CPU预算
+ * @note  新的预算周期从调用时刻开始, 用量和挂起次数清零。
+ * @param task_h 目标任务句柄, NULL 表示当前任务
+ * @param budget_ticks 每个周期的预算(Tick), 0 表示取消预算限制
+ * @param period_ticks 周期(Tick), 不能小于预算
+ * @return 成功返回0，参数无效返回-1
+ */
+int Task_SetBudget(TaskHandle_t task_h, uint32_t budget_ticks, uint32_t period_ticks) {
+    Task_t *task = (task_h == NULL) ? currentTask : task_h;
+    if (task == NULL || task == idleTask || (budget_ticks != 0 && period_ticks < budget_ticks))
+        return -1;
+    MyRTOS_Port_EnterCritical();
+    task->budget = budget_ticks;
+    task->budgetPeriod = (budget_ticks != 0) ? period_ticks : 0;
+    task->budgetPeriodEnd = MyRTOS_GetTick() + task->budgetPeriod;
+    task->budgetUsed = 0;
+    task->budgetExhaustions = 0;
+    MyRTOS_Port_ExitCritical();
+    return 0;
+}
+#endif
 
 /**
  * @brief 挂起指定的任务.
@@ -284,10 +588,11 @@ void Task_Suspend(TaskHandle_t task_h) {
     } else if (task_to_suspend->state == TASK_STATE_DELAYED || task_to_suspend->state == TASK_STATE_BLOCKED) {
         // 任务可能同时在延迟列表和事件列表中
         if(task_to_suspend->delay > 0) {
-            removeTaskFromList(get_delayed_task_list_head(), task_to_suspend);
+            removeTaskFromDelayList(task_to_suspend);
         }
         if(task_to_suspend->pEventList != NULL) {
             eventListRemove(task_to_suspend);
+            mutexWaitAborted(task_to_suspend);
         }
     }
     // 设置状态为挂起.
@@ -318,7 +623,7 @@ void Task_Resume(TaskHandle_t task_h) {
         addTaskToReadyList(task_to_resume);
 
         // 检查是否需要进行上下文切换.
-        if (task_to_resume->priority > currentTask->priority) {
+        if (scheduler_task_preempts_current(task_to_resume)) {
             trigger_yield = 1;
         }
     }
@@ -343,7 +648,7 @@ int Task_Notify(TaskHandle_t task_h) {
             task_h->is_waiting_notification = 0;
             addTaskToReadyList(task_h);
             // 如果被唤醒的任务优先级更高，则需要进行调度
-            if (task_h->priority > currentTask->priority) {
+            if (scheduler_task_preempts_current(task_h)) {
                 trigger_yield = 1;
             }
         }
@@ -368,7 +673,7 @@ int Task_NotifyFromISR(TaskHandle_t task_h, int *higherPriorityTaskWoken) {
         if (task_h->is_waiting_notification && task_h->state == TASK_STATE_BLOCKED) {
             task_h->is_waiting_notification = 0;
             addTaskToReadyList(task_h);
-            if (task_h->priority > currentTask->priority) {
+            if (scheduler_task_preempts_current(task_h)) {
                 *higherPriorityTaskWoken = 1;
             }
         }
@@ -427,6 +732,45 @@ uint32_t Task_GetId(TaskHandle_t task_h) {
     return ((Task_t *) task_h)->taskId;
 }
 
+/**
+ * @brief 根据任务ID查找任务句柄, O(1)
+ * @param id 任务ID
+ * @return 该ID当前对应的任务句柄, ID未被使用时返回 NULL
+ */
+TaskHandle_t Task_GetById(uint32_t id) {
+    if (id >= MYRTOS_MAX_CONCURRENT_TASKS)
+        return NULL;
+    return taskSlotTable[id];
+}
+
+/**
+ * @brief 获取任务的引用值
+ * @param task_h 任务句柄, NULL 表示当前任务
+ * @return 任务引用值, 高16位为槽位代数, 低16位为任务ID
+ */
+TaskRef_t Task_GetRef(TaskHandle_t task_h) {
+    Task_t *task = (task_h == NULL) ? currentTask : task_h;
+    return ((TaskRef_t) task->taskGeneration << 16) | task->taskId;
+}
+
+/**
+ * @brief 将任务引用解析为任务句柄, O(1)
+ * @param ref 任务引用值
+ * @return 任务仍然存在时返回其句柄, 引用已过期时返回 NULL
+ */
+TaskHandle_t Task_FromRef(TaskRef_t ref) {
+    uint32_t id = ref & 0xFFFFU;
+    if (id >= MYRTOS_MAX_CONCURRENT_TASKS)
+        return NULL;
+    TaskHandle_t task = NULL;
+    MyRTOS_Port_EnterCritical();
+    if (taskSlotGeneration[id] == (uint16_t) (ref >> 16)) {
+        task = taskSlotTable[id];
+    }
+    MyRTOS_Port_ExitCritical();
+    return task;
+}
+
 /**
  * @brief 获取任务的名称。
  * @param task_h 要查询的任务句柄。
@@ -451,8 +795,8 @@ TaskHandle_t Task_FindByName(const char *taskName) {
     if (taskName == NULL) {
         return NULL;
     }
-    // 进入临界区以安全地遍历全局任务列表
-    MyRTOS_Port_EnterCritical();
+    // 全局任务列表只在任务上下文中修改, 锁定调度器即可安全遍历, 不必关中断
+    MyRTOS_Schedule_Lock();
     Task_t *p_iterator = allTaskListHead;
     while (p_iterator != NULL) {
         // 使用 strcmp 比较任务名称
@@ -462,6 +806,6 @@ TaskHandle_t Task_FindByName(const char *taskName) {
         }
         p_iterator = p_iterator->pNextTask;
     }
-    MyRTOS_Port_ExitCritical();
+    MyRTOS_Schedule_Unlock();
     return found_task;
 }
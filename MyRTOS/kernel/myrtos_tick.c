@@ -6,16 +6,58 @@
 #include "myrtos_kernel.h"
 
 /*===========================================================================*
- * 外部函数声明
+ * 私有变量
  *===========================================================================*/
-extern TaskHandle_t *get_delayed_task_list_head(void);
+
+// 系统滴答计数器的低32位和高32位
+// 只在滴答中断 (或关中断的Tick补偿) 中更新, 读取方无需临界区, 见 MyRTOS_GetTick
+static volatile uint32_t systemTickLow = 0;
+static volatile uint32_t systemTickHigh = 0;
+#if MYRTOS_USE_TICKLESS_IDLE == 1
+// 低功耗空闲模式下被跳过的Tick总数
+static volatile uint64_t suppressedTickCount = 0;
+#endif
 
 /*===========================================================================*
- * 私有变量
+ * 私有函数
  *===========================================================================*/
 
-// 系统滴答计数器
-static volatile uint64_t systemTickCount = 0;
+/**
+ * @brief 系统滴答计数加一
+ * @note  必须在临界区内调用。先写低32位, 回绕时再进位高32位。
+ * @return 加一之后的系统滴答计数
+ */
+static inline uint64_t tick_increment(void) {
+    const uint32_t low = systemTickLow + 1;
+    systemTickLow = low;
+    if (low == 0) {
+        systemTickHigh++;
+    }
+    return ((uint64_t) systemTickHigh << 32) | low;
+}
+
+/**
+ * @brief 推进延迟时间轮并唤醒指定Tick到期的任务
+ * @param current_tick 当前系统滴答计数
+ * @return 如果唤醒了应抢占当前任务的任务 (优先级更高, 或同在EDF优先级且截止时间更早)，返回1，否则返回0
+ */
+static int wake_expired_tasks(uint64_t current_tick) {
+    int higherPriorityTaskWoken = 0;
+    // 推进时间轮, 取出本Tick到期的任务
+    TaskList_t *pExpiredList = delayListAdvance(current_tick);
+    while (pExpiredList->head != NULL) {
+        Task_t *taskToWake = pExpiredList->head;
+        // 从延迟时间轮中移除
+        removeTaskFromDelayList(taskToWake);
+        taskToWake->delay = 0;
+        // 添加到就绪链表
+        addTaskToReadyList(taskToWake);
+        if (scheduler_task_preempts_current(taskToWake)) {
+            higherPriorityTaskWoken = 1;
+        }
+    }
+    return higherPriorityTaskWoken;
+}
 
 /*===========================================================================*
  * 公开接口实现
@@ -23,46 +65,115 @@ static volatile uint64_t systemTickCount = 0;
 
 /**
  * @brief 获取当前系统滴答计数
- * @note  此函数是线程安全的。
+ * @note  此函数是线程安全的, 且不关中断。计数的两半按 高-低-高 的顺序读取,
+ *        两次读到的高32位不同说明读取期间发生了低32位回绕, 重新读取即可。
+ *        写入方 (滴答中断) 在临界区内更新计数, 能调用内核接口的中断不会看到更新到一半的值,
+ *        因此重读只会发生在读取方被滴答中断打断之后, 不会无限循环。
  * @return 返回自调度器启动以来的滴答数
  */
 uint64_t MyRTOS_GetTick(void) {
-    MyRTOS_Port_EnterCritical();
-    const uint64_t tick_value = systemTickCount;
-    MyRTOS_Port_ExitCritical();
-    return tick_value;
+    uint32_t high;
+    uint32_t low;
+    do {
+        high = systemTickHigh;
+        low = systemTickLow;
+    } while (high != systemTickHigh);
+    return ((uint64_t) high << 32) | low;
 }
 
+/**
+ * @brief 获取当前系统滴答计数的低32位
+ * @note  单次字读取, 开销最小。只需要相对时间的调用者应使用此函数,
+ *        并以 MyRTOS_TickElapsed32 计算间隔, 计数回绕 (1kHz 下约49.7天) 不影响结果。
+ * @return 系统滴答计数的低32位
+ */
+uint32_t MyRTOS_GetTick32(void) { return systemTickLow; }
+
 /**
  * @brief 系统滴答中断处理函数
  * @note  此函数应在系统滴答定时器中断（如SysTick_Handler）中调用。
  *        它负责增加系统滴答计数，并检查是否有延迟的任务需要被唤醒。
  */
 int MyRTOS_Tick_Handler(void) {
-    int higherPriorityTaskWoken = 0;
-    TaskHandle_t *pDelayedListHead = get_delayed_task_list_head();
-
-    // 增加系统滴答计数
-    systemTickCount++;
-    const uint64_t current_tick = systemTickCount;
-    // 检查延迟链表头，看是否有任务的唤醒时间已到
-    while (*pDelayedListHead != NULL && (*pDelayedListHead)->delay <= current_tick) {
-        Task_t *taskToWake = *pDelayedListHead;
-        // 从延迟链表中移除
-        removeTaskFromList(pDelayedListHead, taskToWake);
-        taskToWake->delay = 0;
-        // 添加到就绪链表
-        addTaskToReadyList(taskToWake);
-        if (taskToWake->priority > currentTask->priority) {
-            higherPriorityTaskWoken = 1;
-        }
+    // 增加系统滴答计数, 唤醒本Tick到期的任务
+    const uint64_t now = tick_increment();
+    int higherPriorityTaskWoken = wake_expired_tasks(now);
+#if MYRTOS_USE_BUDGET == 1
+    // 收取当前任务的CPU预算, 用完时挂起到周期结束, 不再消耗时间片
+    if (scheduler_budget_tick(now)) {
+        higherPriorityTaskWoken = 1;
+    } else
+#endif
+    // 消耗当前任务的时间片, 耗尽时轮转到同优先级的下一个任务
+    if (scheduler_time_slice_tick()) {
+        higherPriorityTaskWoken = 1;
     }
     // 广播滴答事件
-    KernelEventData_t eventData = {.eventType = KERNEL_EVENT_TICK};
-    broadcast_event(&eventData);
+    if (extension_event_wanted(KERNEL_EVENT_TICK)) {
+        KernelEventData_t eventData = {.eventType = KERNEL_EVENT_TICK};
+        broadcast_event(&eventData);
+    }
     return higherPriorityTaskWoken;
 }
 
+#if MYRTOS_USE_TICKLESS_IDLE == 1
+/**
+ * @brief 计算空闲任务可以连续休眠的Tick数
+ * @note  只有在关中断 (或临界区) 中调用时结果才是确定的, 移植层据此编程滴答定时器;
+ *        在中断开启时调用得到的只是一个提示, 中断随时可能唤醒任务或改变最近的唤醒时间。
+ *        只有空闲任务就绪时才允许休眠, 休眠时长由延迟时间轮中最近的唤醒时间决定
+ *        (软件定时器服务任务同样以超时等待的方式挂在时间轮上)。
+ * @return 可休眠的Tick数, 0 表示不能休眠
+ */
+uint32_t MyRTOS_Tick_GetExpectedIdleTicks(void) {
+    if (!g_scheduler_started || !scheduler_only_idle_ready()) {
+        return 0;
+    }
+    const uint64_t nextWakeTick = delayListNextWakeTick();
+    const uint64_t now = MyRTOS_GetTick();
+    if (nextWakeTick <= now) {
+        return 0;
+    }
+    const uint64_t idleTicks = nextWakeTick - now;
+    return (idleTicks > UINT32_MAX) ? UINT32_MAX : (uint32_t) idleTicks;
+}
+
+/**
+ * @brief 补偿低功耗休眠期间被跳过的Tick
+ * @note  由移植层在关中断的情况下调用。被跳过的Tick不会广播滴答事件,
+ *        也不应有任务到期 (休眠时长保证了这一点), 这里仍做兜底处理。
+ * @param ticks 被跳过的完整Tick数
+ */
+void MyRTOS_Tick_Step(uint32_t ticks) {
+    int higherPriorityTaskWoken = 0;
+    suppressedTickCount += ticks;
+    while (ticks-- > 0) {
+        higherPriorityTaskWoken |= wake_expired_tasks(tick_increment());
+    }
+    MyRTOS_Port_YieldFromISR(higherPriorityTaskWoken);
+}
+
+/**
+ * @brief 空闲任务的低功耗休眠入口
+ * @note  应在空闲任务的循环中调用, 代替直接执行 WFI。这里在中断开启时计算的休眠时长只是一个提示,
+ *        移植层关中断后会重新计算并取两者中的较小值 (为0时不休眠直接返回)。
+ */
+void MyRTOS_Idle_Sleep(void) {
+    MyRTOS_Port_SuppressTicksAndSleep(MyRTOS_Tick_GetExpectedIdleTicks());
+}
+
+/**
+ * @brief 获取低功耗空闲模式累计跳过的Tick数
+ * @return 自调度器启动以来被跳过 (未产生中断) 的Tick总数
+ */
+uint64_t MyRTOS_GetSuppressedTicks(void) {
+    MyRTOS_Port_EnterCritical();
+    const uint64_t value = suppressedTickCount;
+    MyRTOS_Port_ExitCritical();
+    return value;
+}
+#endif /* MYRTOS_USE_TICKLESS_IDLE */
+
 /**
  * @brief 检查调度器是否正在运行
  * @return 如果调度器已启动，返回1，否则返回0
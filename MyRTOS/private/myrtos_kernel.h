@@ -22,44 +22,126 @@
 // 内存堆中允许的最小内存块大小，至少能容纳两个BlockLink_t结构体
 #define HEAP_MINIMUM_BLOCK_SIZE ((sizeof(BlockLink_t) * 2))
 
+// 延迟时间轮每级槽位数的位宽 (槽位数 = 2^bits), 决定跨轮级联与溢出链表回填的周期 (见 delayListAdvance)
+#ifndef MYRTOS_DELAY_WHEEL_BITS
+#define MYRTOS_DELAY_WHEEL_BITS 6
+#endif
+// 时间轮级数, 超出范围的任务进入溢出链表
+#define DELAY_WHEEL_LEVELS 2
+#define DELAY_WHEEL_SIZE (1UL << MYRTOS_DELAY_WHEEL_BITS)
+#define DELAY_WHEEL_MASK (DELAY_WHEEL_SIZE - 1)
+
+// uint8_t 优先级参数是否越界. MYRTOS_MAX_PRIORITIES 为 256 时所有取值都有效,
+// 比较恒为假且会触发 -Wtype-limits 警告, 因此在编译期去掉
+#if MYRTOS_MAX_PRIORITIES < 256
+#define PRIORITY_OUT_OF_RANGE(priority) ((priority) >= MYRTOS_MAX_PRIORITIES)
+#else
+#define PRIORITY_OUT_OF_RANGE(priority) 0
+#endif
+
+// 同步原语快速路径是否生效: 需要配置开启, 且移植层提供独占访问指令
+#if MYRTOS_USE_SYNC_FAST_PATH == 1 && defined(MYRTOS_PORT_HAS_EXCLUSIVE)
+#define SYNC_FAST_PATH 1
+#else
+#define SYNC_FAST_PATH 0
+#endif
+
 /*===========================================================================*
  * 内核全局变量声明 (extern)
  *===========================================================================*/
 
+#if MYRTOS_USE_HEAP == 1
 // 内存管理
 extern size_t freeBytesRemaining;
+#endif
 
 // 内核状态
 extern volatile uint8_t g_scheduler_started;
 extern volatile uint32_t criticalNestingCount;
 extern TaskHandle_t allTaskListHead;
+extern TaskHandle_t allTaskListTail;
 extern TaskHandle_t currentTask;
 extern TaskHandle_t idleTask;
 
+#if MAX_KERNEL_EXTENSIONS > 0
+// 扩展机制: 所有已注册扩展订阅掩码的并集
+extern volatile uint32_t g_extension_event_mask;
+#endif
+
 /*===========================================================================*
  * 内部函数声明
  *===========================================================================*/
 
 // 调度器相关
 void addTaskToReadyList(TaskHandle_t task);
-void removeTaskFromList(TaskHandle_t *ppListHead, TaskHandle_t taskToRemove);
-void addTaskToSortedDelayList(TaskHandle_t task);
+void removeTaskFromList(TaskList_t *pList, TaskHandle_t taskToRemove);
+void addTaskToDelayList(TaskHandle_t task);
+void removeTaskFromDelayList(TaskHandle_t task);
+TaskList_t *delayListAdvance(uint64_t currentTick);
+uint64_t delayListNextWakeTick(void);
 
 // 事件列表相关
 void eventListInit(EventList_t *pEventList);
 void eventListInsert(EventList_t *pEventList, TaskHandle_t taskToInsert);
 void eventListRemove(TaskHandle_t taskToRemove);
+void eventListSetFifo(EventList_t *pEventList, uint8_t fifo);
+uint8_t eventListHighestPriority(const EventList_t *pEventList, uint8_t floor);
 
 // 信号相关
 int check_signal_wait_condition(TaskHandle_t task);
+int signalSendLocked(TaskHandle_t task, uint32_t signals);
+void objectWatchAttach(ObjectWatch_t **list, ObjectWatch_t *watch);
+int objectWatchNotify(ObjectWatch_t **list);
+
+// 互斥锁相关
+void mutexWaitAborted(TaskHandle_t task);
 
 // 扩展机制
 void broadcast_event(const KernelEventData_t *pEventData);
 
+// 任务管理内部
+void task_slots_init(void);
+
 // 调度器内部
 void scheduler_init(void);
-TaskHandle_t *get_delayed_task_list_head(void);
-TaskHandle_t *get_ready_task_list(uint8_t priority);
+TaskList_t *get_ready_task_list(uint8_t priority);
 void task_set_priority(TaskHandle_t task, uint8_t newPriority);
+void task_set_running_priority(TaskHandle_t task, uint8_t newPriority);
+int scheduler_only_idle_ready(void);
+int readyListRotate(TaskHandle_t task);
+int scheduler_time_slice_tick(void);
+#if MYRTOS_USE_BUDGET == 1
+int scheduler_budget_tick(uint64_t now);
+#endif
+int scheduler_task_preempts_current(TaskHandle_t task);
+int scheduler_ready_preempts_current(void);
+uint8_t scheduler_preempt_threshold(TaskHandle_t task);
+
+// 中断延迟调用
+#if MYRTOS_USE_DEFERRED_CALL == 1
+void deferred_init(void);
+int deferred_daemon_start(void);
+void deferred_wake_daemon(void);
+#endif
+
+/*===========================================================================*
+ * 内联辅助函数
+ *===========================================================================*/
+
+/**
+ * @brief 判断是否有扩展订阅了某个内核事件
+ * @note  广播点应先调用此函数, 无人订阅时连事件数据都不必构造。eventType 为常量时,
+ *        静态钩子部分在编译期求值; 没有运行时注册表且静态钩子未订阅的事件整体被优化掉。
+ * @param eventType 事件类型
+ * @return 有订阅者返回非0
+ */
+static inline int extension_event_wanted(KernelEventType_t eventType) {
+    const uint32_t bit = KERNEL_EVENT_MASK(eventType);
+#if MAX_KERNEL_EXTENSIONS > 0
+    return ((MYRTOS_EXTENSION_STATIC_EVENTS | g_extension_event_mask) & bit) != 0;
+#else
+    return (MYRTOS_EXTENSION_STATIC_EVENTS & bit) != 0;
+#endif
+}
 
 #endif /* MYRTOS_KERNEL_H */
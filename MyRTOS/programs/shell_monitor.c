@@ -23,31 +23,33 @@ static int cmd_ps(shell_handle_t shell, int argc, char *argv[]) {
     (void)argv;
 
     const int COL_WIDTH_NAME = 16;
-    TaskStats_t stats[MYRTOS_MAX_CONCURRENT_TASKS];
-    int count = 0;
-
-    MyRTOS_Port_EnterCritical();
-    TaskHandle_t task = Monitor_GetNextTask(NULL);
-    while (task && count < MYRTOS_MAX_CONCURRENT_TASKS) {
-        Monitor_GetTaskInfo(task, &stats[count++]);
-        task = Monitor_GetNextTask(task);
-    }
-    MyRTOS_Port_ExitCritical();
 
     MyRTOS_printf("\nMyRTOS Monitor (Uptime: %llu ms)\n", TICK_TO_MS(MyRTOS_GetTick()));
     MyRTOS_printf("%-*s %-4s %-8s %-10s %-18s %s\n", COL_WIDTH_NAME, "Task Name", "ID", "State",
                   "Prio(B/C)", "Stack (Used/Size)", "Runtime(us)");
     MyRTOS_printf("--\n");
 
-    for (int i = 0; i < count; ++i) {
-        TaskStats_t *s = &stats[i];
+    // 按任务ID逐个采样, 避免按最大任务数在栈上开辟快照数组
+    for (uint32_t id = 0; id < MYRTOS_MAX_CONCURRENT_TASKS; ++id) {
+        TaskStats_t s;
+        int found = 0;
+        MyRTOS_Port_EnterCritical();
+        TaskHandle_t task = Task_GetById(id);
+        if (task != NULL) {
+            found = (Monitor_GetTaskInfo(task, &s) == 0);
+        }
+        MyRTOS_Port_ExitCritical();
+        if (!found) {
+            continue;
+        }
+
         char prio_str[12], stack_str[20];
-        snprintf(prio_str, sizeof(prio_str), "%u/%u", s->base_priority, s->current_priority);
-        snprintf(stack_str, sizeof(stack_str), "%u/%u", (unsigned)s->stack_high_water_mark_bytes,
-                 (unsigned)s->stack_size_bytes);
-        MyRTOS_printf("%-*s %-4u %-8s %-10s %-18s %llu\n", COL_WIDTH_NAME, s->task_name,
-                      (unsigned)Task_GetId(s->task_handle), g_task_state_str[s->state],
-                      prio_str, stack_str, s->total_runtime);
+        snprintf(prio_str, sizeof(prio_str), "%u/%u", s.base_priority, s.current_priority);
+        snprintf(stack_str, sizeof(stack_str), "%u/%u", (unsigned)s.stack_high_water_mark_bytes,
+                 (unsigned)s.stack_size_bytes);
+        MyRTOS_printf("%-*s %-4u %-8s %-10s %-18s %llu\n", COL_WIDTH_NAME, s.task_name,
+                      (unsigned)id, g_task_state_str[s.state],
+                      prio_str, stack_str, s.total_runtime);
     }
 
     HeapStats_t heap;
@@ -1,6 +1,6 @@
 /**
  * @file  shell_process.c
- * @brief 进程管理命令（run, jobs, kill, fg, bg, ls）
+ * @brief 进程管理命令（run, jobs, kill, fg, bg, budget, ls）
  */
 #include "include/shell.h"
 
@@ -347,6 +347,49 @@ static int cmd_bg(shell_handle_t shell, int argc, char *argv[]) {
     return 0;
 }
 
+#if MYRTOS_USE_BUDGET == 1
+// budget命令，限制进程每个周期最多运行的Tick数
+static int cmd_budget(shell_handle_t shell, int argc, char *argv[]) {
+    (void)shell;
+    if (argc != 4 && argc != 3) {
+        MyRTOS_printf("Usage: budget <pid> <ticks> <period>\n");
+        MyRTOS_printf("       budget <pid> off\n");
+        return -1;
+    }
+
+    int pid = atoi(argv[1]);
+    if (pid <= 0) {
+        MyRTOS_printf("Error: Invalid PID.\n");
+        return -1;
+    }
+
+    uint32_t budget = 0;
+    uint32_t period = 0;
+    if (argc == 4) {
+        budget = (uint32_t)strtoul(argv[2], NULL, 10);
+        period = (uint32_t)strtoul(argv[3], NULL, 10);
+        if (budget == 0 || period < budget) {
+            MyRTOS_printf("Error: Budget must be in 1..period.\n");
+            return -1;
+        }
+    } else if (strcmp(argv[2], "off") != 0) {
+        MyRTOS_printf("Usage: budget <pid> off\n");
+        return -1;
+    }
+
+    if (Process_SetBudget(pid, budget, period) != 0) {
+        MyRTOS_printf("budget: failed to set budget of process %d.\n", pid);
+        return -1;
+    }
+    if (budget == 0) {
+        MyRTOS_printf("[%d] budget removed\n", pid);
+    } else {
+        MyRTOS_printf("[%d] budget %u/%u ticks\n", pid, (unsigned)budget, (unsigned)period);
+    }
+    return 0;
+}
+#endif
+
 void shell_register_process_commands(shell_handle_t shell) {
     shell_register_command(shell, "jobs", "列出所有作业 (别名: progs)", cmd_jobs);
     shell_register_command(shell, "progs", "jobs 命令的别名", cmd_jobs);
@@ -354,6 +397,9 @@ void shell_register_process_commands(shell_handle_t shell) {
     shell_register_command(shell, "kill", "终止一个作业. 用法: kill <pid>", cmd_kill);
     shell_register_command(shell, "fg", "将作业切换到前台. 用法: fg <pid>", cmd_fg);
     shell_register_command(shell, "bg", "在后台恢复挂起的作业. 用法: bg <pid>", cmd_bg);
+#if MYRTOS_USE_BUDGET == 1
+    shell_register_command(shell, "budget", "限制作业的CPU占用. 用法: budget <pid> <ticks> <period>", cmd_budget);
+#endif
     shell_register_command(shell, "ls", "列出所有可执行程序", cmd_ls);
 }
 
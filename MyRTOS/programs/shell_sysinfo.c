@@ -16,6 +16,10 @@
 #include "MyRTOS_VTS.h"
 #endif
 
+#if MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
+#include "MyRTOS_WorkQueue.h"
+#endif
+
 // top命令：实时系统监控
 static int cmd_top(shell_handle_t shell, int argc, char *argv[]) {
     (void)shell;
@@ -42,8 +46,14 @@ static int cmd_top(shell_handle_t shell, int argc, char *argv[]) {
                       (unsigned)heap_stats.minimum_ever_free_bytes);
 
         MyRTOS_printf("----------------------------------------\n");
+#if MYRTOS_USE_BUDGET == 1
+        // BUDGET 列为 本周期已用/预算/周期 (Tick), THR 为因预算用完被挂起的次数
+        MyRTOS_printf("%-12s %-8s %-5s %-9s %-6s %-15s %-5s\n",
+                      "NAME", "STATE", "PRIO", "STACK", "CPU%", "BUDGET", "THR");
+#else
         MyRTOS_printf("%-12s %-8s %-5s %-9s %-6s\n",
                       "NAME", "STATE", "PRIO", "STACK", "CPU%");
+#endif
         MyRTOS_printf("----------------------------------------\n");
 
         // 遍历所有任务
@@ -64,6 +74,22 @@ static int cmd_top(shell_handle_t shell, int argc, char *argv[]) {
                 uint32_t stack_used = stats.stack_size_bytes - stats.stack_high_water_mark_bytes;
                 uint32_t cpu_percent = stats.cpu_usage_permille / 10;  // 千分比转百分比
 
+#if MYRTOS_USE_BUDGET == 1
+                char budget_str[24] = "-";
+                if (stats.budget_ticks != 0) {
+                    snprintf(budget_str, sizeof(budget_str), "%u/%u/%u", (unsigned)stats.budget_used,
+                             (unsigned)stats.budget_ticks, (unsigned)stats.budget_period);
+                }
+                MyRTOS_printf("%-12s %-8s %-5d %4u/%-4u %3u%%   %-15s %-5u\n",
+                              stats.task_name,
+                              state_str,
+                              stats.current_priority,
+                              stack_used,
+                              stats.stack_size_bytes,
+                              cpu_percent,
+                              budget_str,
+                              (unsigned)stats.budget_exhaustions);
+#else
                 MyRTOS_printf("%-12s %-8s %-5d %4u/%-4u %3u%%\n",
                               stats.task_name,
                               state_str,
@@ -71,6 +97,7 @@ static int cmd_top(shell_handle_t shell, int argc, char *argv[]) {
                               stack_used,
                               stats.stack_size_bytes,
                               cpu_percent);
+#endif
             }
         }
 
@@ -97,9 +124,14 @@ static int cmd_cat(shell_handle_t shell, int argc, char *argv[]) {
     (void)shell;
 
     if (argc < 2) {
-        MyRTOS_printf("Usage: cat <heap|tasks>\n");
+        MyRTOS_printf("Usage: cat <heap|tasks|tick|defer|periodic|work|pi>\n");
         MyRTOS_printf("  heap  - 显示堆内存统计\n");
         MyRTOS_printf("  tasks - 显示任务列表\n");
+        MyRTOS_printf("  tick  - 显示系统滴答统计\n");
+        MyRTOS_printf("  defer - 显示中断延迟调用统计\n");
+        MyRTOS_printf("  periodic - 显示周期任务的释放抖动统计\n");
+        MyRTOS_printf("  work  - 显示工作队列统计\n");
+        MyRTOS_printf("  pi    - 显示互斥锁的优先级继承/天花板/竞争释放统计\n");
         return -1;
     }
 
@@ -136,9 +168,89 @@ static int cmd_cat(shell_handle_t shell, int argc, char *argv[]) {
                               stats.task_name, state_str, stats.current_priority);
             }
         }
+    } else if (strcmp(target, "tick") == 0) {
+        uint64_t ticks = MyRTOS_GetTick();
+        MyRTOS_printf("系统滴答统计:\n");
+        MyRTOS_printf("  运行时间:   %lu 毫秒\n", (unsigned long)TICK_TO_MS(ticks));
+        MyRTOS_printf("  滴答总数:   %lu\n", (unsigned long)ticks);
+#if MYRTOS_USE_TICKLESS_IDLE == 1
+        uint64_t suppressed = MyRTOS_GetSuppressedTicks();
+        MyRTOS_printf("  跳过滴答:   %lu\n", (unsigned long)suppressed);
+        MyRTOS_printf("  滴答中断:   %lu\n", (unsigned long)(ticks - suppressed));
+#else
+        MyRTOS_printf("  低功耗空闲: 未启用\n");
+#endif
+    } else if (strcmp(target, "defer") == 0) {
+#if MYRTOS_USE_DEFERRED_CALL == 1
+        MyRTOS_printf("中断延迟调用统计 (单位: CPU周期):\n");
+        MyRTOS_printf("%-4s %-8s %-8s %-8s %-10s %-10s %-10s\n", "SRC", "POSTED", "DROPPED", "EXECUTED",
+                      "AVG_LAT", "MAX_LAT", "MAX_RUN");
+        for (uint32_t src = 0; src < MYRTOS_DEFERRED_MAX_SOURCES; src++) {
+            DeferredStats_t ds;
+            if (MyRTOS_Deferred_GetStats(src, &ds) != 0 || ds.posted + ds.dropped == 0) {
+                continue;
+            }
+            unsigned long avg = ds.executed ? (unsigned long)(ds.totalLatency / ds.executed) : 0;
+            MyRTOS_printf("%-4lu %-8lu %-8lu %-8lu %-10lu %-10lu %-10lu\n", (unsigned long)src,
+                          (unsigned long)ds.posted, (unsigned long)ds.dropped, (unsigned long)ds.executed, avg,
+                          (unsigned long)ds.maxLatency, (unsigned long)ds.maxRunTime);
+        }
+#else
+        MyRTOS_printf("中断延迟调用: 未启用\n");
+#endif
+    } else if (strcmp(target, "periodic") == 0) {
+        MyRTOS_printf("周期任务释放统计 (单位: Tick):\n");
+        MyRTOS_printf("%-16s %-10s %-8s %-8s %-8s\n", "NAME", "RELEASES", "AVG_JIT", "MAX_JIT", "OVERRUN");
+        TaskHandle_t task_h = NULL;
+        while ((task_h = Monitor_GetNextTask(task_h)) != NULL) {
+            TaskStats_t stats;
+            if (Monitor_GetTaskInfo(task_h, &stats) != 0 || stats.release_count + stats.release_overruns == 0) {
+                continue;
+            }
+            unsigned long avg = stats.release_count ? (unsigned long)(stats.release_jitter_total / stats.release_count) : 0;
+            MyRTOS_printf("%-16s %-10lu %-8lu %-8lu %-8lu\n", stats.task_name, (unsigned long)stats.release_count, avg,
+                          (unsigned long)stats.release_jitter_max, (unsigned long)stats.release_overruns);
+        }
+    } else if (strcmp(target, "work") == 0) {
+#if MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
+        MyRTOS_printf("工作队列统计 (延迟单位: Tick):\n");
+        MyRTOS_printf("%-6s %-5s %-10s %-10s %-10s %-8s\n", "LEVEL", "PRIO", "SUBMITTED", "EXECUTED", "CANCELLED",
+                      "MAX_LAT");
+        for (uint8_t level = 0; level < MYRTOS_WORKQUEUE_LEVELS; level++) {
+            WorkQueueStats_t ws;
+            if (WorkQueue_GetStats(level, &ws) != 0) {
+                continue;
+            }
+            MyRTOS_printf("%-6u %-5u %-10lu %-10lu %-10lu %-8lu\n", (unsigned)level,
+                          (unsigned)(MYRTOS_WORKQUEUE_BASE_PRIORITY + level), (unsigned long)ws.submitted,
+                          (unsigned long)ws.executed, (unsigned long)ws.cancelled, (unsigned long)ws.max_latency);
+        }
+#else
+        MyRTOS_printf("工作队列: 未启用\n");
+#endif
+    } else if (strcmp(target, "pi") == 0) {
+        MutexStats_t is;
+        Mutex_GetStats(&is);
+        MyRTOS_printf("优先级继承统计:\n");
+        MyRTOS_printf("  提升次数:   %lu (其中传递 %lu)\n", (unsigned long)is.boosts, (unsigned long)is.transitiveBoosts);
+        MyRTOS_printf("  最长链深度: %lu (上限 %d, 截断 %lu 次)\n", (unsigned long)is.maxDepth,
+                      MYRTOS_MUTEX_INHERIT_DEPTH, (unsigned long)is.depthLimitHits);
+        MyRTOS_printf("  天花板违例: %lu\n", (unsigned long)is.ceilingViolations);
+        MyRTOS_printf("  竞争释放:   唤醒 %lu 次, 避免护航 %lu 次\n", (unsigned long)is.competitiveWakeups,
+                      (unsigned long)is.convoysAvoided);
+        MyRTOS_printf("%-16s %-6s %-6s %-8s\n", "NAME", "BASE", "PRIO", "BOOSTS");
+        TaskHandle_t task_h = NULL;
+        while ((task_h = Monitor_GetNextTask(task_h)) != NULL) {
+            TaskStats_t stats;
+            if (Monitor_GetTaskInfo(task_h, &stats) != 0 || stats.inherit_boosts == 0) {
+                continue;
+            }
+            MyRTOS_printf("%-16s %-6u %-6u %-8lu\n", stats.task_name, (unsigned)stats.base_priority,
+                          (unsigned)stats.current_priority, (unsigned long)stats.inherit_boosts);
+        }
     } else {
         MyRTOS_printf("Error: Unknown target '%s'.\n", target);
-        MyRTOS_printf("Available targets: heap, tasks\n");
+        MyRTOS_printf("Available targets: heap, tasks, tick, defer, periodic, work, pi\n");
         return -1;
     }
 
@@ -147,7 +259,7 @@ static int cmd_cat(shell_handle_t shell, int argc, char *argv[]) {
 
 void shell_register_sysinfo_commands(shell_handle_t shell) {
     shell_register_command(shell, "top", "实时系统监控工具", cmd_top);
-    shell_register_command(shell, "cat", "查看系统信息 (heap|tasks)", cmd_cat);
+    shell_register_command(shell, "cat", "查看系统信息 (heap|tasks|tick|defer|periodic|work|pi)", cmd_cat);
 }
 
 #else
@@ -11,6 +11,9 @@
 #include "MyRTOS_Utils.h"
 #include "MyRTOS_Port.h"
 #include "MyRTOS_AsyncIO.h"
+#if MYRTOS_ASYNCIO_USE_WORKQUEUE == 1
+#include "MyRTOS_WorkQueue.h"
+#endif
 
 
 
@@ -27,6 +30,25 @@ static QueueHandle_t g_request_queue = NULL;
 
 static MutexHandle_t g_async_request_lock = NULL;
 
+#if MYRTOS_ASYNCIO_USE_WORKQUEUE == 1
+// 把队列中的写请求全部执行完的工作项, 每次发送请求后提交
+static WorkItem_t g_async_drain_work;
+
+/**
+ * @brief   在工作线程中执行队列中积压的全部写请求。
+ * @details 队列取空后工作项回到空闲状态; 期间新发送的请求会重新提交工作项, 不会遗留在队列中。
+ */
+static void AsyncWriter_Drain(WorkItem_t *item, void *arg) {
+    (void)item;
+    (void)arg;
+    AsyncWriteRequest_t request;
+    while (Queue_Receive(g_request_queue, &request, 0) != 0) {
+        if (request.target_stream) {
+            Stream_Write(request.target_stream, request.message, strlen(request.message), 0);
+        }
+    }
+}
+#else
 /**
  * @brief   异步I/O服务的后台工作任务。
  * @details
@@ -48,6 +70,7 @@ static void AsyncWriter_Task(void *param) {
         }
     }
 }
+#endif
 
 // -------------------- 公共API实现 --------------------
 
@@ -70,6 +93,9 @@ int AsyncIOService_Init(void) {
         g_async_request_lock = NULL;
         return -1; // 队列创建失败
     }
+#if MYRTOS_ASYNCIO_USE_WORKQUEUE == 1
+    WorkItem_Init(&g_async_drain_work, AsyncWriter_Drain, NULL, MYRTOS_ASYNCIO_WORK_LEVEL);
+#else
     TaskHandle_t task_h = Task_Create(AsyncWriter_Task, "AsyncIO", MYRTOS_ASYNCIO_TASK_STACK_SIZE, NULL,
                                       MYRTOS_ASYNCIO_TASK_PRIORITY);
 
@@ -78,6 +104,7 @@ int AsyncIOService_Init(void) {
         g_request_queue = NULL;
         return -1; //任务创建失败
     }
+#endif
     return 0;
 }
 
@@ -95,6 +122,9 @@ void MyRTOS_AsyncVPrintf(StreamHandle_t stream, const char *format, va_list args
     // 使用封装的工具格式化字符串
     MyRTOS_FormatV(request.message, sizeof(request.message), format, args);
     Queue_Send(g_request_queue, &request, MS_TO_TICKS(MYRTOS_ASYNCIO_QUEUE_SEND_TIMEOUT));
+#if MYRTOS_ASYNCIO_USE_WORKQUEUE == 1
+    WorkQueue_Submit(&g_async_drain_work);
+#endif
     if (MyRTOS_Schedule_IsRunning()) {
         Mutex_Unlock(g_async_request_lock);
     }
@@ -0,0 +1,268 @@
+/**
+ * @file  MyRTOS_Coroutine.c
+ * @brief MyRTOS 协程服务 - 实现
+ */
+#include "MyRTOS_Coroutine.h"
+
+#if MYRTOS_SERVICE_COROUTINE_ENABLE == 1
+
+#include <stddef.h>
+#include "MyRTOS.h"
+#include "MyRTOS_Port.h"
+
+/*============================== 私有函数 ==============================*/
+
+/**
+ * @brief 协程是否在等待中且不需要运行
+ * @note  等待队列/信号量的协程在观察者触发 (pList 被内核清为NULL) 之前不运行;
+ *        观察者在读取之后才触发时, 内核发出的唤醒信号使宿主任务立即开始下一轮。
+ */
+static inline int coroutine_waiting(const Coroutine_t *co) {
+    return co->state == CO_STATUS_SLEEP || (co->state == CO_STATUS_WATCH && co->watch.pList != NULL);
+}
+
+/**
+ * @brief 协程信号是否满足当前的等待条件
+ * @note  必须在临界区中调用。
+ */
+static inline int coroutine_signal_ready(const Coroutine_t *co) {
+    return co->signal_mask != 0 && (co->signals & co->signal_mask) != 0;
+}
+
+/**
+ * @brief 把其他任务新启动的协程并入宿主任务的链表
+ * @note  协程链表只由宿主任务访问, 其他任务只能写入 pending 链表, 因此链表遍历无需加锁。
+ */
+static void scheduler_merge_pending(CoScheduler_t *sched) {
+    if (sched->pending == NULL) {
+        return;
+    }
+    MyRTOS_Port_EnterCritical();
+    Coroutine_t *pending = sched->pending;
+    sched->pending = NULL;
+    MyRTOS_Port_ExitCritical();
+    while (pending != NULL) {
+        Coroutine_t *co = pending;
+        pending = co->next;
+        co->next = sched->head;
+        sched->head = co;
+    }
+}
+
+/*============================== 公共API实现 ==============================*/
+
+void CoScheduler_Init(CoScheduler_t *sched) {
+    if (sched == NULL) {
+        return;
+    }
+    sched->head = NULL;
+    sched->pending = NULL;
+    sched->host = NULL;
+    sched->count = 0;
+    sched->resumes = 0;
+}
+
+/**
+ * @brief 宿主任务主循环
+ * @note  每一轮依次运行所有可运行的协程: 让出的协程和以 CO_AWAIT 等待任意条件的协程每轮都运行,
+ *        睡眠的协程在超时或收到信号后运行, 等待队列/信号量的协程在超时或观察者触发后运行。
+ *        没有协程可以立即运行时, 宿主任务等待唤醒信号, 最长等到最近的超时时刻 (没有超时则永久等待);
+ *        只有在有协程以 CO_AWAIT 等待时才最长等待 MYRTOS_COROUTINE_POLL_TICKS。
+ */
+void CoScheduler_Task(void *param) {
+    CoScheduler_t *sched = (CoScheduler_t *) param;
+    sched->host = Task_GetCurrentTaskHandle();
+    for (;;) {
+        scheduler_merge_pending(sched);
+
+        const uint64_t now = MyRTOS_GetTick();
+        uint64_t next_wake = UINT64_MAX;
+        int runnable = 0;
+        int polling = 0;
+        Coroutine_t **link = &sched->head;
+        Coroutine_t *co;
+        while ((co = *link) != NULL) {
+            if (coroutine_waiting(co) && now < co->wake_time) {
+                if (co->wake_time < next_wake) {
+                    next_wake = co->wake_time;
+                }
+                link = &co->next;
+                continue;
+            }
+
+            sched->resumes++;
+            const CoStatus_t status = co->func(co, co->arg);
+            switch (status) {
+                case CO_STATUS_DONE:
+                    // 从链表中移除, 控制块交还给调用者
+                    *link = co->next;
+                    co->next = NULL;
+                    co->sched = NULL;
+                    MyRTOS_Port_EnterCritical();
+                    co->signal_mask = 0;
+                    co->state = CO_STATUS_DONE;
+                    sched->count--;
+                    MyRTOS_Port_ExitCritical();
+                    continue;
+                case CO_STATUS_SLEEP:
+                    // 信号可能在协程检查之后、这里设置状态之前到达
+                    MyRTOS_Port_EnterCritical();
+                    co->state = coroutine_signal_ready(co) ? CO_STATUS_YIELD : CO_STATUS_SLEEP;
+                    MyRTOS_Port_ExitCritical();
+                    break;
+                default:
+                    co->state = status;
+                    break;
+            }
+            if (co->state == CO_STATUS_YIELD) {
+                runnable = 1;
+            } else {
+                if (co->state == CO_STATUS_POLL) {
+                    polling = 1;
+                }
+                if (co->wake_time < next_wake) {
+                    next_wake = co->wake_time;
+                }
+            }
+            link = &co->next;
+        }
+
+        if (runnable) {
+            // 让同优先级的其他任务也有机会运行
+            Task_Yield();
+            continue;
+        }
+        uint32_t timeout = polling ? MYRTOS_COROUTINE_POLL_TICKS : MYRTOS_MAX_DELAY;
+        if (next_wake != UINT64_MAX) {
+            const uint64_t current = MyRTOS_GetTick();
+            if (next_wake <= current) {
+                continue;
+            }
+            if (next_wake - current < timeout) {
+                timeout = (uint32_t) (next_wake - current);
+            }
+        }
+        Task_WaitSignal(MYRTOS_COROUTINE_WAKE_SIGNAL, timeout, SIGNAL_WAIT_ANY | SIGNAL_CLEAR_ON_EXIT);
+    }
+}
+
+int Coroutine_Start(CoScheduler_t *sched, Coroutine_t *co, const char *name, CoroutineFunc_t func, void *arg) {
+    if (sched == NULL || co == NULL || func == NULL || co->sched != NULL) {
+        return -1;
+    }
+    co->func = func;
+    co->arg = arg;
+    co->name = name;
+    co->wake_time = UINT64_MAX;
+    co->signals = 0;
+    co->signal_mask = 0;
+    co->received = 0;
+    co->watch.next = NULL;
+    co->watch.pList = NULL;
+    co->watch.task = NULL;
+    co->watch.signal = MYRTOS_COROUTINE_WAKE_SIGNAL;
+    co->line = 0;
+    co->state = CO_STATUS_YIELD;
+    co->timed_out = 0;
+
+    TaskHandle_t host;
+    MyRTOS_Port_EnterCritical();
+    co->sched = sched;
+    co->next = sched->pending;
+    sched->pending = co;
+    sched->count++;
+    host = sched->host;
+    MyRTOS_Port_ExitCritical();
+
+    if (host != NULL && host != Task_GetCurrentTaskHandle()) {
+        Task_SendSignal(host, MYRTOS_COROUTINE_WAKE_SIGNAL);
+    }
+    return 0;
+}
+
+int Coroutine_Signal(Coroutine_t *co, uint32_t signals) {
+    if (co == NULL || signals == 0) {
+        return -1;
+    }
+    TaskHandle_t host = NULL;
+    MyRTOS_Port_EnterCritical();
+    if (co->sched == NULL) {
+        MyRTOS_Port_ExitCritical();
+        return -1;
+    }
+    co->signals |= signals;
+    if (co->state == CO_STATUS_SLEEP && coroutine_signal_ready(co)) {
+        co->state = CO_STATUS_YIELD;
+        host = co->sched->host;
+    }
+    MyRTOS_Port_ExitCritical();
+
+    if (host != NULL && host != Task_GetCurrentTaskHandle()) {
+        Task_SendSignal(host, MYRTOS_COROUTINE_WAKE_SIGNAL);
+    }
+    return 0;
+}
+
+int Coroutine_SignalFromISR(Coroutine_t *co, uint32_t signals, int *higherPriorityTaskWoken) {
+    if (co == NULL || signals == 0) {
+        return -1;
+    }
+    TaskHandle_t host = NULL;
+    MyRTOS_Port_EnterCritical();
+    if (co->sched == NULL) {
+        MyRTOS_Port_ExitCritical();
+        return -1;
+    }
+    co->signals |= signals;
+    if (co->state == CO_STATUS_SLEEP && coroutine_signal_ready(co)) {
+        co->state = CO_STATUS_YIELD;
+        host = co->sched->host;
+    }
+    MyRTOS_Port_ExitCritical();
+
+    if (host != NULL) {
+        Task_SendSignalFromISR(host, MYRTOS_COROUTINE_WAKE_SIGNAL, higherPriorityTaskWoken);
+    }
+    return 0;
+}
+
+/*============================== 宏辅助函数 ==============================*/
+
+void Coroutine_SetTimeout(Coroutine_t *co, uint32_t ticks) {
+    co->wake_time = (ticks == MYRTOS_MAX_DELAY) ? UINT64_MAX : MyRTOS_GetTick() + ticks;
+    co->signal_mask = 0;
+}
+
+int Coroutine_Expired(const Coroutine_t *co) {
+    return co->wake_time != UINT64_MAX && MyRTOS_GetTick() >= co->wake_time;
+}
+
+uint32_t Coroutine_TakeSignals(Coroutine_t *co) {
+    MyRTOS_Port_EnterCritical();
+    const uint32_t received = co->signals & co->signal_mask;
+    if (received != 0) {
+        co->signals &= ~received;
+        co->signal_mask = 0;
+    }
+    MyRTOS_Port_ExitCritical();
+    co->received = received;
+    return received;
+}
+
+int Coroutine_WatchQueue(Coroutine_t *co, QueueHandle_t queue) {
+    co->watch.task = co->sched->host;
+    return Queue_Watch(queue, &co->watch);
+}
+
+int Coroutine_WatchSemaphore(Coroutine_t *co, SemaphoreHandle_t sem) {
+    co->watch.task = co->sched->host;
+    return Semaphore_Watch(sem, &co->watch);
+}
+
+void Coroutine_Unwatch(Coroutine_t *co) {
+    if (co->watch.pList != NULL) {
+        ObjectWatch_Cancel(&co->watch);
+    }
+}
+
+#endif // MYRTOS_SERVICE_COROUTINE_ENABLE == 1
@@ -29,7 +29,7 @@ typedef struct {
 
 /*============================== 模块全局变量 ==============================*/
 
-// 用于存储所有任务StdIO信息的数组，大小由内核配置决定
+// 用于存储所有任务StdIO信息的数组，以任务ID为下标，大小由内核配置决定
 static TaskStdIO_t g_task_stdio_map[MYRTOS_MAX_CONCURRENT_TASKS];
 // 默认的系统标准流 (比如可以指向一个UART流)
 StreamHandle_t g_system_stdin = NULL;
@@ -53,8 +53,9 @@ static void stdio_kernel_event_handler(const KernelEventData_t *pEventData) {
     switch (pEventData->eventType) {
         case KERNEL_EVENT_TASK_CREATE: {
             // 新任务创建时，为其分配一个StdIO槽位
-            TaskStdIO_t *new_stdio = find_task_stdio(NULL); // 找一个空槽位
-            if (new_stdio) {
+            uint32_t id = Task_GetId(pEventData->task); // 槽位以任务ID为下标
+            if (id < MYRTOS_MAX_CONCURRENT_TASKS) {
+                TaskStdIO_t *new_stdio = &g_task_stdio_map[id];
                 new_stdio->task_handle = pEventData->task;
                 TaskHandle_t parent_task = Task_GetCurrentTaskHandle();
                 if (parent_task) {
@@ -92,14 +93,13 @@ static void stdio_kernel_event_handler(const KernelEventData_t *pEventData) {
 
 /*============================== 辅助函数 ==============================*/
 
-// 查找或分配一个任务的StdIO槽位
+// 查找一个任务的StdIO槽位, 槽位表以任务ID为下标, 查找为 O(1)
 static TaskStdIO_t *find_task_stdio(TaskHandle_t task_h) {
-    for (int i = 0; i < MYRTOS_MAX_CONCURRENT_TASKS; ++i) {
-        if (g_task_stdio_map[i].task_handle == task_h) {
-            return &g_task_stdio_map[i];
-        }
+    uint32_t id = Task_GetId(task_h);
+    if (id >= MYRTOS_MAX_CONCURRENT_TASKS || g_task_stdio_map[id].task_handle != task_h) {
+        return NULL; // 未找到
     }
-    return NULL; // 未找到
+    return &g_task_stdio_map[id];
 }
 
 /*============================== 公共API实现 ==============================*/
@@ -107,7 +107,8 @@ static TaskStdIO_t *find_task_stdio(TaskHandle_t task_h) {
 int StdIOService_Init(void) {
     memset(g_task_stdio_map, 0, sizeof(g_task_stdio_map));
     // 向内核注册事件处理器
-    return MyRTOS_RegisterExtension(stdio_kernel_event_handler);
+    return MyRTOS_RegisterExtension(stdio_kernel_event_handler, KERNEL_EVENT_MASK(KERNEL_EVENT_TASK_CREATE) |
+                                                                KERNEL_EVENT_MASK(KERNEL_EVENT_TASK_DELETE));
 }
 
 StreamHandle_t Stream_GetTaskStdIn(TaskHandle_t task_h) {
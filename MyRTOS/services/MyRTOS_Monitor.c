@@ -35,23 +35,13 @@ static size_t g_min_ever_free_bytes;
  *                              私有函数                                      *
  *===========================================================================*/
 
-// 查找任务的现有插槽或为新任务分配一个插槽。
-static InternalTaskStats_t *find_or_alloc_stat_slot(TaskHandle_t task_h) {
-    // 首先，尝试为给定的任务句柄找到现有的插槽
-    for (int i = 0; i < MYRTOS_MAX_CONCURRENT_TASKS; ++i) {
-        if (g_task_stats_map[i].task_handle == task_h) {
-            return &g_task_stats_map[i];
-        }
-    }
-    // 如果 task_h 为 NULL，表示我们要为新任务找一个空插槽
-    if (task_h == NULL) {
-        for (int i = 0; i < MYRTOS_MAX_CONCURRENT_TASKS; ++i) {
-            if (g_task_stats_map[i].task_handle == NULL) {
-                return &g_task_stats_map[i];
-            }
-        }
+// 查找任务的统计插槽。插槽表以任务ID为下标, 查找为 O(1)。
+static InternalTaskStats_t *find_stat_slot(TaskHandle_t task_h) {
+    uint32_t id = Task_GetId(task_h);
+    if (id >= MYRTOS_MAX_CONCURRENT_TASKS || g_task_stats_map[id].task_handle != task_h) {
+        return NULL; // 未找到插槽
     }
-    return NULL; // 未找到插槽
+    return &g_task_stats_map[id];
 }
 
 // 内核事件处理函数，被动收集所有监控数据。
@@ -64,15 +54,15 @@ static void monitor_kernel_event_handler(const KernelEventData_t *pEventData) {
 
     switch (pEventData->eventType) {
         case KERNEL_EVENT_TASK_CREATE: {
-            InternalTaskStats_t *slot = find_or_alloc_stat_slot(NULL);
-            if (slot) {
-                slot->task_handle = pEventData->task;
-                slot->runtime_counter = 0;
+            uint32_t id = Task_GetId(pEventData->task);
+            if (id < MYRTOS_MAX_CONCURRENT_TASKS) {
+                g_task_stats_map[id].task_handle = pEventData->task;
+                g_task_stats_map[id].runtime_counter = 0;
             }
             break;
         }
         case KERNEL_EVENT_TASK_DELETE: {
-            InternalTaskStats_t *slot = find_or_alloc_stat_slot(pEventData->task);
+            InternalTaskStats_t *slot = find_stat_slot(pEventData->task);
             if (slot) {
                 slot->task_handle = NULL;
             }
@@ -90,7 +80,7 @@ static void monitor_kernel_event_handler(const KernelEventData_t *pEventData) {
                 delta_hires = (0xFFFFFFFF - last_hires) + now_hires + 1;
             }
 
-            InternalTaskStats_t *slot = find_or_alloc_stat_slot(pEventData->task);
+            InternalTaskStats_t *slot = find_stat_slot(pEventData->task);
             if (slot) {
                 slot->runtime_counter += delta_hires; // 将正确的32位增量累加到64位计数器上
             }
@@ -131,7 +121,12 @@ int Monitor_Init(const MonitorConfig_t *config) {
     g_last_switch_time = g_get_hires_timer_value();
     MyRTOS_Port_ExitCritical();
 
-    return MyRTOS_RegisterExtension(monitor_kernel_event_handler);
+    return MyRTOS_RegisterExtension(monitor_kernel_event_handler,
+                                    KERNEL_EVENT_MASK(KERNEL_EVENT_TASK_CREATE) |
+                                    KERNEL_EVENT_MASK(KERNEL_EVENT_TASK_DELETE) |
+                                    KERNEL_EVENT_MASK(KERNEL_EVENT_TASK_SWITCH_OUT) |
+                                    KERNEL_EVENT_MASK(KERNEL_EVENT_TASK_SWITCH_IN) |
+                                    KERNEL_EVENT_MASK(KERNEL_EVENT_MALLOC) | KERNEL_EVENT_MASK(KERNEL_EVENT_FREE));
 }
 
 TaskHandle_t Monitor_GetNextTask(TaskHandle_t previous_handle) {
@@ -161,9 +156,33 @@ int Monitor_GetTaskInfo(TaskHandle_t task_h, TaskStats_t *p_stats_out) {
         p_stats_out->current_priority = tcb->priority;
         p_stats_out->base_priority = tcb->basePriority;
         p_stats_out->stack_size_bytes = tcb->stackSize_words * sizeof(StackType_t);
+        p_stats_out->release_count = tcb->releaseCount;
+        p_stats_out->release_jitter_max = tcb->releaseJitterMax;
+        p_stats_out->release_jitter_total = tcb->releaseJitterTotal;
+        p_stats_out->release_overruns = tcb->releaseOverruns;
+        p_stats_out->inherit_boosts = tcb->inheritBoosts;
+#if MYRTOS_USE_EDF == 1
+        p_stats_out->relative_deadline = tcb->relativeDeadline;
+        p_stats_out->deadline_misses = tcb->deadlineMisses;
+#else
+        p_stats_out->relative_deadline = 0;
+        p_stats_out->deadline_misses = 0;
+#endif
+#if MYRTOS_USE_BUDGET == 1
+        p_stats_out->budget_ticks = tcb->budget;
+        p_stats_out->budget_period = tcb->budgetPeriod;
+        // 周期已过但任务尚未再次运行时, 预算实际上已经补满
+        p_stats_out->budget_used = (MyRTOS_GetTick() >= tcb->budgetPeriodEnd) ? 0 : tcb->budgetUsed;
+        p_stats_out->budget_exhaustions = tcb->budgetExhaustions;
+#else
+        p_stats_out->budget_ticks = 0;
+        p_stats_out->budget_period = 0;
+        p_stats_out->budget_used = 0;
+        p_stats_out->budget_exhaustions = 0;
+#endif
 
         // 从收集的统计信息中填充运行时信息
-        InternalTaskStats_t *run_stats = find_or_alloc_stat_slot(task_h);
+        InternalTaskStats_t *run_stats = find_stat_slot(task_h);
         if (run_stats) {
             p_stats_out->total_runtime = run_stats->runtime_counter;
         } else {
@@ -175,11 +194,12 @@ int Monitor_GetTaskInfo(TaskHandle_t task_h, TaskStats_t *p_stats_out) {
         local_stack_size_words = tcb->stackSize_words;
     }
     MyRTOS_Port_ExitCritical();
+#if MYRTOS_TASK_STACK_PAINT == 1
     uint32_t unused_words = 0;
     if (local_stack_base != NULL) {
         // 增加一个安全检查
         StackType_t *stack_ptr = local_stack_base;
-        while (unused_words < local_stack_size_words && *stack_ptr == 0xA5A5A5A5) {
+        while (unused_words < local_stack_size_words && *stack_ptr == MYRTOS_STACK_PAINT_VALUE) {
             unused_words++;
             stack_ptr++;
         }
@@ -187,6 +207,12 @@ int Monitor_GetTaskInfo(TaskHandle_t task_h, TaskStats_t *p_stats_out) {
 
     // 已使用部分是总大小减去未使用部分
     p_stats_out->stack_high_water_mark_bytes = (local_stack_size_words - unused_words) * sizeof(StackType_t);
+#else
+    // 栈未填充, 无法统计
+    (void) local_stack_base;
+    (void) local_stack_size_words;
+    p_stats_out->stack_high_water_mark_bytes = 0;
+#endif
 
     p_stats_out->cpu_usage_permille = 0; // 这个在ps命令里计算
 
@@ -84,7 +84,7 @@ void Process_Init(void) {
     g_next_pid = 1;
 
     // 注册内核事件处理器
-    if (MyRTOS_RegisterExtension(process_kernel_event_handler) != 0) {
+    if (MyRTOS_RegisterExtension(process_kernel_event_handler, KERNEL_EVENT_MASK(KERNEL_EVENT_TASK_DELETE)) != 0) {
         // 致命错误
         while (1);
     }
@@ -309,6 +309,30 @@ int Process_Resume(pid_t pid) {
     return result;
 }
 
+#if MYRTOS_USE_BUDGET == 1
+/**
+ * @brief 限制进程的CPU占用
+ */
+int Process_SetBudget(pid_t pid, uint32_t budget_ticks, uint32_t period_ticks) {
+    int result = -1;
+
+    Mutex_Lock(g_process_lock);
+    Process_t *proc = find_process_by_pid_locked(pid);
+    if (proc != NULL && proc->state != PROCESS_STATE_ZOMBIE) {
+        result = Task_SetBudget(proc->task, budget_ticks, period_ticks);
+    }
+    if (result == 0) {
+        LOG_D("Process", "Budget of process '%s' (PID %d) set to %u/%u ticks.", proc->name, proc->pid,
+              (unsigned) budget_ticks, (unsigned) period_ticks);
+    } else {
+        LOG_W("Process", "SetBudget failed: PID %d not found or invalid budget.", pid);
+    }
+    Mutex_Unlock(g_process_lock);
+
+    return result;
+}
+#endif
+
 // ============================================
 // 进程信息查询实现
 // ============================================
@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include "MyRTOS.h"
+#include "MyRTOS_Port.h"
 
 /*============================== 内部数据结构 ==============================*/
 
@@ -22,8 +23,11 @@ typedef struct Timer_t {
     uint8_t is_periodic;
     volatile bool is_active;
     struct Timer_t *p_next; // 用于构建有序的活动定时器链表
+    uint8_t is_static; // 控制块由调用者提供, 删除时不释放
 } Timer_t;
 
+_Static_assert(sizeof(StaticTimer_t) == sizeof(Timer_t), "StaticTimer_t does not match Timer_t.");
+
 // 发送给定时器服务任务的命令类型
 typedef enum { TIMER_CMD_START, TIMER_CMD_STOP, TIMER_CMD_DELETE, TIMER_CMD_CHANGE_PERIOD } TimerCommandType_t;
 
@@ -38,6 +42,14 @@ typedef struct {
 
 static TaskHandle_t g_timer_service_task_handle = NULL;
 static QueueHandle_t g_timer_command_queue = NULL;
+// 命令队列是单例, 总是静态分配
+static StaticQueue_t g_timer_command_queue_cb;
+static uint8_t g_timer_command_queue_storage[MYRTOS_TIMER_COMMAND_QUEUE_SIZE * sizeof(TimerCommand_t)];
+#if MYRTOS_USE_HEAP == 0
+// 没有内存堆时, 定时器服务任务使用固定大小的静态栈
+static StaticTask_t g_timer_service_task_cb;
+static StackType_t g_timer_service_task_stack[MYRTOS_TIMER_TASK_STACK_SIZE];
+#endif
 // 活动定时器链表头，按到期时间升序排列
 static TimerHandle_t g_active_timer_list_head = NULL;
 
@@ -136,7 +148,11 @@ static void process_timer_command(const TimerCommand_t *command) {
             // 已经在上面移除了，无需额外操作
             break;
         case TIMER_CMD_DELETE:
-            MyRTOS_Free(timer); // 释放定时器内存
+#if MYRTOS_USE_HEAP == 1
+            if (!timer->is_static) {
+                MyRTOS_Free(timer); // 释放定时器内存
+            }
+#endif
             break;
         case TIMER_CMD_CHANGE_PERIOD:
             timer->period = command->value;
@@ -174,13 +190,23 @@ int TimerService_Init(uint8_t timer_task_priority, uint16_t timer_task_stack_siz
         return 0; // 防止重复初始化
 
     // 创建命令队列，队列深度可配置
-    g_timer_command_queue = Queue_Create(MYRTOS_TIMER_COMMAND_QUEUE_SIZE, sizeof(TimerCommand_t));
+    g_timer_command_queue = Queue_CreateStatic(MYRTOS_TIMER_COMMAND_QUEUE_SIZE, sizeof(TimerCommand_t),
+                                               g_timer_command_queue_storage, &g_timer_command_queue_cb);
     if (g_timer_command_queue == NULL)
         return -1;
 
     // 创建定时器服务任务
+#if MYRTOS_USE_HEAP == 1
     g_timer_service_task_handle =
             Task_Create(TimerServiceTask, "TimerSvc", timer_task_stack_size, NULL, timer_task_priority);
+#else
+    if (timer_task_stack_size > MYRTOS_TIMER_TASK_STACK_SIZE) {
+        timer_task_stack_size = MYRTOS_TIMER_TASK_STACK_SIZE;
+    }
+    g_timer_service_task_handle =
+            Task_CreateStatic(TimerServiceTask, "TimerSvc", timer_task_stack_size, NULL, timer_task_priority,
+                              g_timer_service_task_stack, &g_timer_service_task_cb);
+#endif
     if (g_timer_service_task_handle == NULL) {
         Queue_Delete(g_timer_command_queue);
         return -1;
@@ -188,20 +214,38 @@ int TimerService_Init(uint8_t timer_task_priority, uint16_t timer_task_stack_siz
     return 0;
 }
 
+// 初始化定时器控制块
+static void timer_init(Timer_t *timer, const char *name, uint32_t period, uint8_t is_periodic,
+                       TimerCallback_t callback, void *p_timer_arg, uint8_t is_static) {
+    timer->name = name;
+    timer->period = (period == 0) ? 1 : period; // 周期至少为1 tick
+    timer->is_periodic = is_periodic;
+    timer->callback = callback;
+    timer->p_timer_arg = p_timer_arg;
+    timer->is_active = false;
+    timer->p_next = NULL;
+    timer->is_static = is_static;
+}
+
+#if MYRTOS_USE_HEAP == 1
 TimerHandle_t Timer_Create(const char *name, uint32_t period, uint8_t is_periodic, TimerCallback_t callback,
                            void *p_timer_arg) {
     TimerHandle_t timer = (TimerHandle_t) MyRTOS_Malloc(sizeof(Timer_t));
     if (timer) {
-        timer->name = name;
-        timer->period = (period == 0) ? 1 : period; // 周期至少为1 tick
-        timer->is_periodic = is_periodic;
-        timer->callback = callback;
-        timer->p_timer_arg = p_timer_arg;
-        timer->is_active = false;
-        timer->p_next = NULL;
+        timer_init(timer, name, period, is_periodic, callback, p_timer_arg, 0);
     }
     return timer;
 }
+#endif
+
+TimerHandle_t Timer_CreateStatic(const char *name, uint32_t period, uint8_t is_periodic, TimerCallback_t callback,
+                                 void *p_timer_arg, StaticTimer_t *timer_buffer) {
+    if (timer_buffer == NULL)
+        return NULL;
+    TimerHandle_t timer = (TimerHandle_t) timer_buffer;
+    timer_init(timer, name, period, is_periodic, callback, p_timer_arg, 1);
+    return timer;
+}
 
 // 统一的命令发送函数
 static int send_command_to_timer_task(TimerHandle_t timer, TimerCommandType_t cmd, uint32_t value,
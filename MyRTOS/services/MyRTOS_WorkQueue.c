@@ -0,0 +1,357 @@
+/**
+ * @file  MyRTOS_WorkQueue.c
+ * @brief MyRTOS 工作队列服务 - 实现
+ * @note  每个级别有一个待执行链表和一个计数信号量, 提交工作项即追加到链表并释放一次信号量。
+ *        延迟的工作项按到期时间排在一个公共链表中, 由空闲的工作线程在等待信号量之前搬到待执行链表,
+ *        工作线程的等待超时就是最近的到期时间。工作项是侵入式的双向链表节点, 提交和取消都不分配内存。
+ */
+#include "MyRTOS_WorkQueue.h"
+
+#if MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
+
+#include <string.h>
+#include "MyRTOS.h"
+#include "MyRTOS_Port.h"
+
+/*============================== 内部数据结构 ==============================*/
+
+// 工作项链表
+typedef struct {
+    WorkItem_t *head;
+    WorkItem_t *tail;
+} WorkList_t;
+
+// 一个级别的待执行队列
+typedef struct {
+    WorkList_t pending; // 待执行的工作项, 按提交顺序排列
+    SemaphoreHandle_t sem; // 待执行工作项计数, 工作线程在此等待
+    StaticSemaphore_t sem_cb;
+    WorkQueueStats_t stats;
+} WorkLevel_t;
+
+// 信号量计数上限, 超出后的释放会失败, 只会少唤醒一次空闲的工作线程, 不会丢失工作项
+#define WORKQUEUE_SEM_MAX_COUNT 0xFFFFU
+
+#define WORKQUEUE_WORKER_COUNT (MYRTOS_WORKQUEUE_LEVELS * MYRTOS_WORKQUEUE_WORKERS_PER_LEVEL)
+
+/*============================== 模块全局变量 ==============================*/
+
+static WorkLevel_t g_levels[MYRTOS_WORKQUEUE_LEVELS];
+// 延迟的工作项, 按到期时间升序排列
+static WorkList_t g_delayed;
+static volatile uint8_t g_workqueue_ready = 0;
+static StaticTask_t g_worker_tcbs[WORKQUEUE_WORKER_COUNT];
+static StackType_t g_worker_stacks[WORKQUEUE_WORKER_COUNT][MYRTOS_WORKQUEUE_STACK_SIZE];
+
+/*============================== 私有函数 ==============================*/
+
+// 以下链表操作都必须在临界区中调用
+
+static void work_list_append(WorkList_t *list, WorkItem_t *item) {
+    item->next = NULL;
+    item->prev = list->tail;
+    if (list->tail != NULL) {
+        list->tail->next = item;
+    } else {
+        list->head = item;
+    }
+    list->tail = item;
+}
+
+static void work_list_remove(WorkList_t *list, WorkItem_t *item) {
+    if (item->prev != NULL) {
+        item->prev->next = item->next;
+    } else {
+        list->head = item->next;
+    }
+    if (item->next != NULL) {
+        item->next->prev = item->prev;
+    } else {
+        list->tail = item->prev;
+    }
+    item->next = NULL;
+    item->prev = NULL;
+}
+
+/**
+ * @brief 按到期时间插入延迟链表, 到期时间相同的按提交顺序排列
+ */
+static void work_list_insert_sorted(WorkList_t *list, WorkItem_t *item) {
+    WorkItem_t *pos = list->tail;
+    while (pos != NULL && pos->expiry > item->expiry) {
+        pos = pos->prev;
+    }
+    if (pos == NULL) {
+        item->prev = NULL;
+        item->next = list->head;
+        if (list->head != NULL) {
+            list->head->prev = item;
+        } else {
+            list->tail = item;
+        }
+        list->head = item;
+    } else {
+        item->prev = pos;
+        item->next = pos->next;
+        if (pos->next != NULL) {
+            pos->next->prev = item;
+        } else {
+            list->tail = item;
+        }
+        pos->next = item;
+    }
+}
+
+/**
+ * @brief 把工作项从它当前所在的链表中移除
+ */
+static void work_detach(WorkItem_t *item) {
+    if (item->state == WORK_STATE_PENDING) {
+        work_list_remove(&g_levels[item->level].pending, item);
+    } else if (item->state == WORK_STATE_DELAYED) {
+        work_list_remove(&g_delayed, item);
+    }
+}
+
+/**
+ * @brief 把工作项追加到所属级别的待执行链表
+ * @note  expiry 改为记录进入队列的时刻, 用于统计等待执行的延迟。
+ */
+static void work_enqueue_pending(WorkItem_t *item, uint64_t now) {
+    WorkLevel_t *level = &g_levels[item->level];
+    item->expiry = now;
+    item->state = WORK_STATE_PENDING;
+    work_list_append(&level->pending, item);
+    level->stats.submitted++;
+}
+
+/**
+ * @brief 把已到期的延迟工作项搬到待执行链表
+ * @return 距离下一个延迟工作项到期的Tick数, 没有延迟工作项时返回 MYRTOS_MAX_DELAY
+ */
+static uint32_t workqueue_promote_delayed(void) {
+    for (;;) {
+        MyRTOS_Port_EnterCritical();
+        WorkItem_t *item = g_delayed.head;
+        const uint64_t now = MyRTOS_GetTick();
+        if (item == NULL) {
+            MyRTOS_Port_ExitCritical();
+            return MYRTOS_MAX_DELAY;
+        }
+        if (item->expiry > now) {
+            const uint64_t wait = item->expiry - now;
+            MyRTOS_Port_ExitCritical();
+            return (wait >= MYRTOS_MAX_DELAY) ? MYRTOS_MAX_DELAY - 1 : (uint32_t) wait;
+        }
+        work_list_remove(&g_delayed, item);
+        work_enqueue_pending(item, now);
+        const uint8_t level = item->level;
+        MyRTOS_Port_ExitCritical();
+        Semaphore_Give(g_levels[level].sem);
+    }
+}
+
+/**
+ * @brief 唤醒所有级别的一个空闲工作线程, 使其按新的最早到期时间重新等待
+ */
+static void workqueue_kick_all(void) {
+    for (uint8_t i = 0; i < MYRTOS_WORKQUEUE_LEVELS; i++) {
+        Semaphore_Give(g_levels[i].sem);
+    }
+}
+
+/**
+ * @brief 工作线程
+ * @note  信号量计数可能多于待执行的工作项 (延迟链表更新时的唤醒), 取不到工作项时直接重新等待。
+ */
+static void WorkQueue_WorkerTask(void *param) {
+    WorkLevel_t *level = (WorkLevel_t *) param;
+    for (;;) {
+        const uint32_t timeout = workqueue_promote_delayed();
+        if (Semaphore_Take(level->sem, timeout) == 0) {
+            continue;
+        }
+
+        MyRTOS_Port_EnterCritical();
+        WorkItem_t *item = level->pending.head;
+        if (item != NULL) {
+            work_list_remove(&level->pending, item);
+            item->state = WORK_STATE_RUNNING;
+            const uint64_t latency = MyRTOS_GetTick() - item->expiry;
+            if (latency > level->stats.max_latency) {
+                level->stats.max_latency = (latency > UINT32_MAX) ? UINT32_MAX : (uint32_t) latency;
+            }
+        }
+        MyRTOS_Port_ExitCritical();
+        if (item == NULL) {
+            continue;
+        }
+
+        item->func(item, item->arg);
+
+        // 执行期间被重新提交或延迟的工作项不产生完成通知, 以最后一次执行为准
+        MyRTOS_Port_EnterCritical();
+        level->stats.executed++;
+        const int finished = (item->state == WORK_STATE_RUNNING);
+        const WorkFunc_t on_complete = item->on_complete;
+        const TaskHandle_t notify_task = item->notify_task;
+        const uint32_t notify_signals = item->notify_signals;
+        MyRTOS_Port_ExitCritical();
+        if (!finished) {
+            continue;
+        }
+        if (on_complete != NULL) {
+            on_complete(item, item->arg);
+        }
+        MyRTOS_Port_EnterCritical();
+        if (item->state == WORK_STATE_RUNNING) {
+            item->state = WORK_STATE_IDLE;
+        }
+        MyRTOS_Port_ExitCritical();
+        // 工作项回到空闲状态后可能已被调用者释放, 此后只使用复制出来的通知参数
+        if (notify_task != NULL && notify_signals != 0) {
+            Task_SendSignal(notify_task, notify_signals);
+        }
+    }
+}
+
+/*============================== 公共API实现 ==============================*/
+
+int WorkQueue_Init(void) {
+    if (g_workqueue_ready) {
+        return 0;
+    }
+    memset(g_levels, 0, sizeof(g_levels));
+    g_delayed.head = NULL;
+    g_delayed.tail = NULL;
+    for (uint8_t i = 0; i < MYRTOS_WORKQUEUE_LEVELS; i++) {
+        g_levels[i].sem = Semaphore_CreateStatic(WORKQUEUE_SEM_MAX_COUNT, 0, &g_levels[i].sem_cb);
+        if (g_levels[i].sem == NULL) {
+            return -1;
+        }
+    }
+    g_workqueue_ready = 1;
+    for (uint32_t i = 0; i < WORKQUEUE_WORKER_COUNT; i++) {
+        const uint8_t level = (uint8_t) (i / MYRTOS_WORKQUEUE_WORKERS_PER_LEVEL);
+        TaskHandle_t task_h =
+                Task_CreateStatic(WorkQueue_WorkerTask, "Worker", MYRTOS_WORKQUEUE_STACK_SIZE, &g_levels[level],
+                                  MYRTOS_WORKQUEUE_BASE_PRIORITY + level, g_worker_stacks[i], &g_worker_tcbs[i]);
+        if (task_h == NULL) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void WorkItem_Init(WorkItem_t *item, WorkFunc_t func, void *arg, uint8_t level) {
+    if (item == NULL) {
+        return;
+    }
+    memset(item, 0, sizeof(WorkItem_t));
+    item->func = func;
+    item->arg = arg;
+    item->level = (level < MYRTOS_WORKQUEUE_LEVELS) ? level : MYRTOS_WORKQUEUE_LEVELS - 1;
+    item->state = WORK_STATE_IDLE;
+}
+
+void WorkItem_SetCompletion(WorkItem_t *item, WorkFunc_t on_complete, TaskHandle_t notify_task,
+                            uint32_t notify_signals) {
+    if (item == NULL) {
+        return;
+    }
+    MyRTOS_Port_EnterCritical();
+    item->on_complete = on_complete;
+    item->notify_task = notify_task;
+    item->notify_signals = notify_signals;
+    MyRTOS_Port_ExitCritical();
+}
+
+WorkState_t WorkItem_GetState(const WorkItem_t *item) {
+    return (item != NULL) ? (WorkState_t) item->state : WORK_STATE_IDLE;
+}
+
+int WorkQueue_Submit(WorkItem_t *item) {
+    if (item == NULL || item->func == NULL || !g_workqueue_ready) {
+        return -1;
+    }
+    MyRTOS_Port_EnterCritical();
+    if (item->state == WORK_STATE_PENDING) {
+        MyRTOS_Port_ExitCritical();
+        return 0;
+    }
+    work_detach(item);
+    work_enqueue_pending(item, MyRTOS_GetTick());
+    MyRTOS_Port_ExitCritical();
+    Semaphore_Give(g_levels[item->level].sem);
+    return 0;
+}
+
+int WorkQueue_SubmitFromISR(WorkItem_t *item, int *higherPriorityTaskWoken) {
+    if (item == NULL || item->func == NULL || !g_workqueue_ready) {
+        return -1;
+    }
+    MyRTOS_Port_EnterCritical();
+    if (item->state == WORK_STATE_PENDING) {
+        MyRTOS_Port_ExitCritical();
+        return 0;
+    }
+    work_detach(item);
+    work_enqueue_pending(item, MyRTOS_GetTick());
+    MyRTOS_Port_ExitCritical();
+    // Semaphore_GiveFromISR 不接受 NULL, 调用者不关心是否唤醒时使用局部变量, 否则工作线程不会被唤醒
+    int woken = 0;
+    Semaphore_GiveFromISR(g_levels[item->level].sem, &woken);
+    if (higherPriorityTaskWoken != NULL) {
+        *higherPriorityTaskWoken = woken;
+    }
+    return 0;
+}
+
+int WorkQueue_SubmitDelayed(WorkItem_t *item, uint32_t delay_ticks) {
+    if (delay_ticks == 0) {
+        return WorkQueue_Submit(item);
+    }
+    if (item == NULL || item->func == NULL || !g_workqueue_ready) {
+        return -1;
+    }
+    MyRTOS_Port_EnterCritical();
+    work_detach(item);
+    item->expiry = MyRTOS_GetTick() + delay_ticks;
+    item->state = WORK_STATE_DELAYED;
+    work_list_insert_sorted(&g_delayed, item);
+    const int new_head = (g_delayed.head == item);
+    MyRTOS_Port_ExitCritical();
+    // 最早到期时间提前了, 空闲的工作线程需要按新的时间重新等待
+    if (new_head) {
+        workqueue_kick_all();
+    }
+    return 0;
+}
+
+int WorkQueue_Cancel(WorkItem_t *item) {
+    if (item == NULL || !g_workqueue_ready) {
+        return -1;
+    }
+    int result = -1;
+    MyRTOS_Port_EnterCritical();
+    if (item->state == WORK_STATE_PENDING || item->state == WORK_STATE_DELAYED) {
+        work_detach(item);
+        item->state = WORK_STATE_IDLE;
+        g_levels[item->level].stats.cancelled++;
+        result = 0;
+    }
+    MyRTOS_Port_ExitCritical();
+    return result;
+}
+
+int WorkQueue_GetStats(uint8_t level, WorkQueueStats_t *stats_out) {
+    if (level >= MYRTOS_WORKQUEUE_LEVELS || stats_out == NULL) {
+        return -1;
+    }
+    MyRTOS_Port_EnterCritical();
+    *stats_out = g_levels[level].stats;
+    MyRTOS_Port_ExitCritical();
+    return 0;
+}
+
+#endif // MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
@@ -21,10 +21,36 @@
 #include "MyRTOS_IO.h"
 #include <stdarg.h>
 
+/**
+ * @brief 是否由工作队列服务执行写请求
+ * @details 1: 不再创建专用的后台任务, 写请求由工作队列 MYRTOS_ASYNCIO_WORK_LEVEL 级别的工作线程执行,
+ *          节省一个任务的栈和TCB; 0: 使用专用的后台任务。
+ */
+#ifndef MYRTOS_ASYNCIO_USE_WORKQUEUE
+#define MYRTOS_ASYNCIO_USE_WORKQUEUE 0
+#endif
+
+/** @brief 执行写请求的工作队列级别 */
+#ifndef MYRTOS_ASYNCIO_WORK_LEVEL
+#define MYRTOS_ASYNCIO_WORK_LEVEL 0
+#endif
+
+#if MYRTOS_ASYNCIO_USE_WORKQUEUE == 1 && (!defined(MYRTOS_SERVICE_WORKQUEUE_ENABLE) || MYRTOS_SERVICE_WORKQUEUE_ENABLE == 0)
+#error "MYRTOS_ASYNCIO_USE_WORKQUEUE requires MYRTOS_SERVICE_WORKQUEUE_ENABLE"
+#endif
+
+#if MYRTOS_ASYNCIO_USE_WORKQUEUE == 1
+#include "MyRTOS_WorkQueue.h"
+// 写请求 (格式化与输出流写入) 在工作线程的栈上执行, 栈不能小于专用后台任务的栈
+#if defined(MYRTOS_ASYNCIO_TASK_STACK_SIZE) && MYRTOS_WORKQUEUE_STACK_SIZE < MYRTOS_ASYNCIO_TASK_STACK_SIZE
+#error "MYRTOS_ASYNCIO_USE_WORKQUEUE requires MYRTOS_WORKQUEUE_STACK_SIZE >= MYRTOS_ASYNCIO_TASK_STACK_SIZE"
+#endif
+#endif
+
 /**
  * @brief   初始化并启动异步 I/O 服务。
  * @details 此函数必须在调度器启动前，且在使用任何异步打印函数前被调用。
- *          它会创建后台任务和所需的消息队列。
+ *          它会创建后台任务和所需的消息队列; 使用工作队列时只创建消息队列, 工作队列服务必须先初始化。
  *          函数内部是线程安全的 做了幂等性设计 可以重复掉
  *
  * @return  int     0 表示成功, -1 表示失败
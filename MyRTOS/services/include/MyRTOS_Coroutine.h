@@ -0,0 +1,293 @@
+/**
+ * @brief MyRTOS 协程服务 - 公共接口
+ * @details 无栈协程 (protothread 风格): 大量协程在同一个宿主任务中协作式运行, 共用宿主任务的栈。
+ *          每个协程只占一个 Coroutine_t 控制块, 没有独立的栈, 协程之间的切换只是一次函数返回和调用。
+ *          协程可以等待队列、信号量、协程信号和超时, 等待期间宿主任务继续运行其他协程。
+ *          等待队列和信号量时协程在对象上挂载观察者 (ObjectWatch_t), 对象可用时由内核唤醒宿主任务,
+ *          等待期间不轮询; 只有等待任意条件的 CO_AWAIT 需要周期性地重新检查。
+ *
+ *          使用限制:
+ *          - 协程函数中的局部变量在让出 (CO_YIELD/CO_DELAY/CO_AWAIT_*) 之后不保留,
+ *            需要跨越等待点的状态应放在协程自己的上下文结构体中 (通过 arg 传入)。
+ *          - CO_BEGIN 和 CO_END 之间不能再使用 switch 语句, 同一行源代码中最多使用一个 CO_ 宏。
+ *          - 协程中不能调用会阻塞的内核API, 否则整个宿主任务中的协程都会被阻塞。
+ */
+
+#ifndef MYRTOS_COROUTINE_H
+#define MYRTOS_COROUTINE_H
+
+#include "MyRTOS_Service_Config.h"
+
+
+#ifndef MYRTOS_SERVICE_COROUTINE_ENABLE
+#define MYRTOS_SERVICE_COROUTINE_ENABLE 0
+#endif
+
+
+#if MYRTOS_SERVICE_COROUTINE_ENABLE == 1
+
+#include <stdint.h>
+#include "MyRTOS.h"
+
+/** @brief 有协程以 CO_AWAIT 等待任意条件时, 宿主任务两次检查之间的最长间隔 (Tick) */
+#ifndef MYRTOS_COROUTINE_POLL_TICKS
+#define MYRTOS_COROUTINE_POLL_TICKS 1
+#endif
+
+/** @brief 用于唤醒宿主任务的任务信号位, 宿主任务中的其他代码不得使用该信号 */
+#ifndef MYRTOS_COROUTINE_WAKE_SIGNAL
+#define MYRTOS_COROUTINE_WAKE_SIGNAL (1UL << 31)
+#endif
+
+/**
+ * @brief 协程函数的返回值, 告诉宿主任务何时再次运行该协程
+ * @note  由 CO_ 宏产生, 协程函数不需要直接返回这些值。
+ */
+typedef enum {
+    CO_STATUS_YIELD = 0, // 主动让出, 下一轮继续运行
+    CO_STATUS_POLL, // 等待任意条件, 每轮 (最长间隔 MYRTOS_COROUTINE_POLL_TICKS) 重新检查一次
+    CO_STATUS_WATCH, // 等待队列/信号量, 观察者触发或超时后运行, 期间不占用CPU
+    CO_STATUS_SLEEP, // 等待超时或协程信号, 期间不占用CPU
+    CO_STATUS_DONE // 协程已结束
+} CoStatus_t;
+
+struct Coroutine_t;
+struct CoScheduler_t;
+
+/**
+ * @brief 协程函数类型
+ * @param co 协程控制块
+ * @param arg Coroutine_Start 传入的参数
+ * @return 协程状态, 由 CO_ 宏返回
+ */
+typedef CoStatus_t (*CoroutineFunc_t)(struct Coroutine_t *co, void *arg);
+
+/**
+ * @brief 协程控制块
+ * @details 由调用者提供存储 (可以是静态变量或上下文结构体的成员), 成员只由 CO_ 宏和协程服务访问。
+ */
+typedef struct Coroutine_t {
+    CoroutineFunc_t func; // 协程函数
+    void *arg; // 协程函数参数
+    const char *name; // 协程名称
+    struct CoScheduler_t *sched; // 所属的协程调度器, 协程结束后为NULL
+    struct Coroutine_t *next; // 调度器中协程链表的下一节点
+    uint64_t wake_time; // 当前等待的超时时刻(Tick), UINT64_MAX 表示无超时
+    volatile uint32_t signals; // 已收到但尚未处理的协程信号
+    uint32_t signal_mask; // 当前等待的协程信号, 0 表示不在等待信号
+    uint32_t received; // 最近一次 CO_AWAIT_SIGNAL 收到的信号
+    ObjectWatch_t watch; // 等待队列/信号量时挂在对象上的观察者
+    uint16_t line; // 恢复点 (让出处的源代码行号), 0 表示从头开始
+    volatile uint8_t state; // 调度状态, 取值同 CoStatus_t
+    uint8_t timed_out; // 最近一次等待是否超时
+} Coroutine_t;
+
+/**
+ * @brief 协程调度器
+ * @details 一个调度器对应一个宿主任务, 宿主任务以 CoScheduler_Task 为任务函数、调度器为参数创建。
+ */
+typedef struct CoScheduler_t {
+    Coroutine_t *head; // 宿主任务独占的协程链表
+    Coroutine_t *pending; // 其他任务新启动、尚未并入链表的协程
+    TaskHandle_t host; // 宿主任务句柄, 宿主任务运行前为NULL
+    volatile uint32_t count; // 未结束的协程数量
+    uint32_t resumes; // 协程被恢复运行的累计次数
+} CoScheduler_t;
+
+/*===========================================================================*
+ *                      协程函数中使用的宏                                    *
+ *===========================================================================*/
+
+/** @brief 协程函数体的开始 */
+#define CO_BEGIN(co)                                                                                                   \
+    switch ((co)->line) {                                                                                              \
+        case 0:
+
+/** @brief 协程函数体的结束, 协程运行到这里即结束 */
+#define CO_END(co)                                                                                                     \
+    }                                                                                                                  \
+    (co)->line = 0;                                                                                                    \
+    return CO_STATUS_DONE
+
+/** @brief 提前结束协程 */
+#define CO_EXIT(co)                                                                                                    \
+    do {                                                                                                               \
+        (co)->line = 0;                                                                                                \
+        return CO_STATUS_DONE;                                                                                         \
+    } while (0)
+
+/** @brief 让出CPU, 同一调度器中的其他协程运行一轮后继续 */
+#define CO_YIELD(co)                                                                                                   \
+    do {                                                                                                               \
+        (co)->line = __LINE__;                                                                                         \
+        return CO_STATUS_YIELD;                                                                                        \
+        case __LINE__:;                                                                                                \
+    } while (0)
+
+/** @brief 延时指定的Tick数 */
+#define CO_DELAY(co, ticks)                                                                                            \
+    do {                                                                                                               \
+        Coroutine_SetTimeout((co), (ticks));                                                                           \
+        (co)->line = __LINE__;                                                                                         \
+        return CO_STATUS_SLEEP;                                                                                        \
+        case __LINE__:;                                                                                                \
+    } while (0)
+
+/**
+ * @brief 等待条件成立或超时
+ * @details 条件在每一轮调度中重新求值, 因此必须是无阻塞、无副作用 (或副作用只在成立时发生) 的表达式。
+ *          返回后可用 CO_TIMED_OUT 判断是否超时。
+ */
+#define CO_AWAIT(co, cond, timeout)                                                                                    \
+    do {                                                                                                               \
+        Coroutine_SetTimeout((co), (timeout));                                                                         \
+        (co)->line = __LINE__;                                                                                         \
+        if (0) {                                                                                                       \
+            case __LINE__:;                                                                                            \
+        }                                                                                                              \
+        if (cond) {                                                                                                    \
+            (co)->timed_out = 0;                                                                                       \
+        } else if (Coroutine_Expired(co)) {                                                                            \
+            (co)->timed_out = 1;                                                                                       \
+        } else {                                                                                                       \
+            return CO_STATUS_POLL;                                                                                     \
+        }                                                                                                              \
+    } while (0)
+
+/**
+ * @brief 等待内核对象可用或超时
+ * @details cond 不成立时用 attach 在对象上挂载协程的观察者, 对象可用时内核唤醒宿主任务, 再重新求值 cond。
+ *          等待期间协程不被轮询。attach 返回非0 (对象在求值 cond 之后变为可用, 或句柄无效) 时本轮退回轮询。
+ *          供 CO_AWAIT_QUEUE 和 CO_AWAIT_SEMAPHORE 使用。
+ */
+#define CO_AWAIT_WATCH(co, cond, attach, timeout)                                                                      \
+    do {                                                                                                               \
+        Coroutine_SetTimeout((co), (timeout));                                                                         \
+        (co)->line = __LINE__;                                                                                         \
+        if (0) {                                                                                                       \
+            case __LINE__:;                                                                                            \
+        }                                                                                                              \
+        if (cond) {                                                                                                    \
+            Coroutine_Unwatch(co);                                                                                     \
+            (co)->timed_out = 0;                                                                                       \
+        } else if (Coroutine_Expired(co)) {                                                                            \
+            Coroutine_Unwatch(co);                                                                                     \
+            (co)->timed_out = 1;                                                                                       \
+        } else if ((co)->watch.pList != NULL || (attach) == 0) {                                                       \
+            return CO_STATUS_WATCH;                                                                                    \
+        } else {                                                                                                       \
+            return CO_STATUS_POLL;                                                                                     \
+        }                                                                                                              \
+    } while (0)
+
+/** @brief 从队列接收一项数据, 队列为空时等待 */
+#define CO_AWAIT_QUEUE(co, queue, buffer, timeout)                                                                     \
+    CO_AWAIT_WATCH(co, Queue_Receive((queue), (buffer), 0) != 0, Coroutine_WatchQueue((co), (queue)), timeout)
+
+/** @brief 获取信号量, 信号量不可用时等待 */
+#define CO_AWAIT_SEMAPHORE(co, sem, timeout)                                                                           \
+    CO_AWAIT_WATCH(co, Semaphore_Take((sem), 0) != 0, Coroutine_WatchSemaphore((co), (sem)), timeout)
+
+/**
+ * @brief 等待 mask 中的任意协程信号
+ * @details 协程信号由 Coroutine_Signal 发送, 等待期间协程不被轮询。
+ *          收到的信号 (已从待处理信号中清除) 可用 CO_RECEIVED 读取。
+ */
+#define CO_AWAIT_SIGNAL(co, mask, timeout)                                                                             \
+    do {                                                                                                               \
+        Coroutine_SetTimeout((co), (timeout));                                                                         \
+        (co)->signal_mask = (mask);                                                                                    \
+        (co)->line = __LINE__;                                                                                         \
+        if (0) {                                                                                                       \
+            case __LINE__:;                                                                                            \
+        }                                                                                                              \
+        if (Coroutine_TakeSignals(co) != 0) {                                                                          \
+            (co)->timed_out = 0;                                                                                       \
+        } else if (Coroutine_Expired(co)) {                                                                            \
+            (co)->signal_mask = 0;                                                                                     \
+            (co)->timed_out = 1;                                                                                       \
+        } else {                                                                                                       \
+            return CO_STATUS_SLEEP;                                                                                    \
+        }                                                                                                              \
+    } while (0)
+
+/** @brief 最近一次等待是否因超时返回 */
+#define CO_TIMED_OUT(co) ((co)->timed_out)
+
+/** @brief 最近一次 CO_AWAIT_SIGNAL 收到的信号 */
+#define CO_RECEIVED(co) ((co)->received)
+
+/*===========================================================================*
+ *                      公共API                                              *
+ *===========================================================================*/
+
+/**
+ * @brief 初始化协程调度器
+ * @param sched 调度器存储
+ */
+void CoScheduler_Init(CoScheduler_t *sched);
+
+/**
+ * @brief 宿主任务的任务函数
+ * @details 以调度器为参数创建任务即可运行其中的协程, 例如:
+ *          Task_Create(CoScheduler_Task, "Co", 256, &sched, 2);
+ *          宿主任务的栈只需容纳协程函数单次运行的最大深度。所有协程都在等待时宿主任务阻塞。
+ * @param param 协程调度器 (CoScheduler_t *)
+ */
+void CoScheduler_Task(void *param);
+
+/**
+ * @brief 启动一个协程
+ * @details 可以在宿主任务运行之前、在协程中或在其他任务中调用。协程从函数开头运行到 CO_END 结束,
+ *          结束后控制块可以再次用于启动新的协程。
+ * @param sched 协程调度器
+ * @param co 协程控制块, 首次使用前必须清零 (静态变量默认即为零), 协程结束之前不能释放
+ * @param name 协程名称
+ * @param func 协程函数
+ * @param arg 协程函数参数
+ * @return 0 成功, -1 参数无效或控制块仍在使用
+ */
+int Coroutine_Start(CoScheduler_t *sched, Coroutine_t *co, const char *name, CoroutineFunc_t func, void *arg);
+
+/**
+ * @brief 向协程发送信号
+ * @param co 目标协程
+ * @param signals 要发送的信号位
+ * @return 0 成功, -1 协程未运行
+ */
+int Coroutine_Signal(Coroutine_t *co, uint32_t signals);
+
+/**
+ * @brief 在中断中向协程发送信号
+ * @param co 目标协程
+ * @param signals 要发送的信号位
+ * @param higherPriorityTaskWoken [out] 宿主任务被唤醒且需要调度时置1
+ * @return 0 成功, -1 协程未运行
+ */
+int Coroutine_SignalFromISR(Coroutine_t *co, uint32_t signals, int *higherPriorityTaskWoken);
+
+/*===========================================================================*
+ *                      供 CO_ 宏使用的辅助函数                               *
+ *===========================================================================*/
+
+/** @brief 设置当前等待的超时时刻, MYRTOS_MAX_DELAY 表示无超时 */
+void Coroutine_SetTimeout(Coroutine_t *co, uint32_t ticks);
+
+/** @brief 当前等待是否已经超时 */
+int Coroutine_Expired(const Coroutine_t *co);
+
+/** @brief 取走并清除等待中的信号, 结果同时保存在 co->received 中 */
+uint32_t Coroutine_TakeSignals(Coroutine_t *co);
+
+/** @brief 在队列上挂载协程的观察者, 返回值同 Queue_Watch */
+int Coroutine_WatchQueue(Coroutine_t *co, QueueHandle_t queue);
+
+/** @brief 在信号量上挂载协程的观察者, 返回值同 Semaphore_Watch */
+int Coroutine_WatchSemaphore(Coroutine_t *co, SemaphoreHandle_t sem);
+
+/** @brief 取消协程的观察者 (未挂载时什么也不做) */
+void Coroutine_Unwatch(Coroutine_t *co);
+
+#endif // MYRTOS_SERVICE_COROUTINE_ENABLE == 1
+
+#endif // MYRTOS_COROUTINE_H
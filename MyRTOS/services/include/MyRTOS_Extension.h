@@ -5,7 +5,7 @@
 #define MYRTOS_EXTENSION_H
 #include "MyRTOS.h"
 
-#define MAX_KERNEL_EXTENSIONS 8
+#define MAX_KERNEL_EXTENSIONS MYRTOS_MAX_KERNEL_EXTENSIONS
 
 /**
  * @brief 内核事件类型枚举
@@ -34,6 +34,11 @@ typedef enum {
     // KERNEL_EVENT_QUEUE_RECEIVE,
 } KernelEventType_t;
 
+// 事件类型对应的订阅掩码位
+#define KERNEL_EVENT_MASK(eventType) (1UL << (eventType))
+// 订阅全部事件
+#define KERNEL_EVENT_MASK_ALL 0xFFFFFFFFUL
+
 
 /**
  * @brief 内核事件上下文数据结构
@@ -68,12 +73,15 @@ typedef void (*KernelExtensionCallback_t)(const KernelEventData_t *pEventData);
  * @brief 注册一个内核扩展
  *
  * 外部模块（如运行时统计、调试跟踪器）通过此函数
- * 将自己的回调函数注册到内核。
+ * 将自己的回调函数注册到内核。内核只把订阅了的事件分发给回调,
+ * 没有任何扩展订阅的事件 (如任务切换、Tick) 在内核中只剩一次掩码判断。
+ * 重复注册同一个回调会替换其订阅掩码。
  *
  * @param callback 要注册的回调函数指针。
+ * @param event_mask 订阅的事件, 由 KERNEL_EVENT_MASK() 按位或组成。
  * @return 0 成功, -1 失败 (例如，注册表已满)。
  */
-int MyRTOS_RegisterExtension(KernelExtensionCallback_t callback);
+int MyRTOS_RegisterExtension(KernelExtensionCallback_t callback, uint32_t event_mask);
 
 /**
  * @brief 注销一个内核扩展
@@ -83,5 +91,18 @@ int MyRTOS_RegisterExtension(KernelExtensionCallback_t callback);
  */
 int MyRTOS_UnregisterExtension(KernelExtensionCallback_t callback);
 
+#ifdef MYRTOS_EXTENSION_STATIC_HOOK
+/**
+ * @brief 编译期静态扩展钩子
+ *
+ * 由配置文件中的 MYRTOS_EXTENSION_STATIC_HOOK 指定函数名, 由应用实现。
+ * 内核对 MYRTOS_EXTENSION_STATIC_EVENTS 中的事件直接调用它, 不经过函数指针;
+ * 未订阅的事件在编译期被整体移除。
+ *
+ * @param pEventData 指向包含事件信息的结构体。
+ */
+void MYRTOS_EXTENSION_STATIC_HOOK(const KernelEventData_t *pEventData);
+#endif
+
 
 #endif // MYRTOS_EXTENSION_H
@@ -30,6 +30,17 @@ typedef struct {
     uint32_t stack_high_water_mark_bytes; // 栈历史最高使用量 (字节)，值越小表示剩余栈空间越多
     uint64_t total_runtime; // 总运行时间 (单位: 高精度timer ticks)
     uint32_t cpu_usage_permille; // CPU使用率 (千分比)，需由调用者在两个时间点上计算差值得出
+    uint32_t relative_deadline; // EDF相对截止时间 (Tick)，0 表示固定优先级任务
+    uint32_t deadline_misses; // EDF截止时间错过次数，固定优先级任务始终为0
+    uint32_t budget_ticks; // 每个周期的CPU预算 (Tick)，0 表示不受预算限制
+    uint32_t budget_period; // 预算周期 (Tick)
+    uint32_t budget_used; // 当前周期已用的预算 (Tick)
+    uint32_t budget_exhaustions; // 因预算用完被挂起的次数
+    uint32_t release_count; // Task_DelayUntil 按时释放的次数
+    uint32_t release_jitter_max; // 最大释放抖动 (Tick)，即实际开始运行的Tick减去预定释放Tick
+    uint32_t release_jitter_total; // 释放抖动累计 (Tick)，除以 release_count 得到平均值
+    uint32_t release_overruns; // 调用 Task_DelayUntil 时已错过释放点的次数
+    uint32_t inherit_boosts; // 因优先级继承 (包括沿互斥锁链的传递继承) 被提升优先级的次数
 } TaskStats_t;
 
 
@@ -149,6 +149,17 @@ int Process_Suspend(pid_t pid);
  */
 int Process_Resume(pid_t pid);
 
+#if MYRTOS_USE_BUDGET == 1
+/**
+ * @brief 限制进程的CPU占用
+ * @param pid 进程ID
+ * @param budget_ticks 每个周期最多运行的Tick数，0 表示取消限制
+ * @param period_ticks 周期（Tick）
+ * @return 成功返回0，失败返回-1
+ */
+int Process_SetBudget(pid_t pid, uint32_t budget_ticks, uint32_t period_ticks);
+#endif
+
 /*===========================================================================*
  *                          进程信息查询                                      *
  *===========================================================================*/
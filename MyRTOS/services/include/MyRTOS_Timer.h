@@ -17,6 +17,12 @@
 #if MYRTOS_SERVICE_TIMER_ENABLE == 1
 
 #include <stdint.h>
+#include "MyRTOS.h"
+
+/** @brief 未启用内存堆时定时器服务任务的静态栈大小 (字) */
+#ifndef MYRTOS_TIMER_TASK_STACK_SIZE
+#define MYRTOS_TIMER_TASK_STACK_SIZE 512
+#endif
 
 // 前置声明定时器结构体，对外部不透明，实现信息隐藏
 struct Timer_t;
@@ -24,6 +30,19 @@ struct Timer_t;
 /** @brief 软件定时器句柄类型。*/
 typedef struct Timer_t *TimerHandle_t;
 
+/**
+ * @brief 定时器控制块的静态存储, 用于 Timer_CreateStatic。
+ * @details 按相同的成员顺序镜像内部的定时器控制块, 成员不得访问。
+ */
+typedef struct {
+    void *dummy1[3];
+    uint32_t dummy2;
+    uint64_t dummy3;
+    uint8_t dummy4[2];
+    void *dummy5;
+    uint8_t dummy6;
+} StaticTimer_t;
+
 /**
  * @brief 定时器回调函数类型
  * @param timer 触发回调的定时器句柄
@@ -36,7 +55,8 @@ typedef void (*TimerCallback_t)(TimerHandle_t timer);
  *          它会创建一个专用的“定时器服务任务”来管理所有定时器。
  * @param timer_task_priority 定时器服务任务的优先级。通常应设为较高优先级，
  *                            以确保定时器回调的及时性。
- * @param timer_task_stack_size 定时器服务任务的栈大小。
+ * @param timer_task_stack_size 定时器服务任务的栈大小。未启用内存堆 (MYRTOS_USE_HEAP == 0) 时
+ *                              服务任务使用静态栈, 该值不能超过 MYRTOS_TIMER_TASK_STACK_SIZE。
  * @return int 0 成功, -1 失败。
  */
 int TimerService_Init(uint8_t timer_task_priority, uint16_t timer_task_stack_size);
@@ -50,8 +70,19 @@ int TimerService_Init(uint8_t timer_task_priority, uint16_t timer_task_stack_siz
  * @param p_timer_arg   [in] 传递给回调函数的自定义参数。
  * @return TimerHandle_t 成功则返回定时器句柄，失败则返回 NULL。
  */
+#if MYRTOS_USE_HEAP == 1
 TimerHandle_t Timer_Create(const char *name, uint32_t period, uint8_t is_periodic, TimerCallback_t callback,
                            void *p_timer_arg);
+#endif
+
+/**
+ * @brief 使用调用者提供的控制块创建一个软件定时器。
+ * @details 参数含义同 Timer_Create。删除定时器时不会释放 timer_buffer。
+ * @param timer_buffer  [in] 定时器控制块存储。
+ * @return TimerHandle_t 成功则返回定时器句柄，失败则返回 NULL。
+ */
+TimerHandle_t Timer_CreateStatic(const char *name, uint32_t period, uint8_t is_periodic, TimerCallback_t callback,
+                                 void *p_timer_arg, StaticTimer_t *timer_buffer);
 
 /**
  * @brief 启动一个软件定时器。
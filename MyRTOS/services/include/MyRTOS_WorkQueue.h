@@ -0,0 +1,174 @@
+/**
+ * @brief MyRTOS 工作队列服务 - 公共接口
+ * @details 一组按优先级分级的工作线程 (线程池), 执行其他任务、服务或中断提交的工作项。
+ *          需要把工作转移到后台执行的代码不必再各自创建任务和队列, 只需提交一个工作项。
+ *          工作项支持延迟提交、取消和完成通知。
+ *
+ *          同一级别的工作项按提交顺序执行; 级别越高, 工作线程的优先级越高。
+ *          工作函数可以阻塞, 但会占用所在级别的一个工作线程, 长时间阻塞的工作应放在单独的级别。
+ */
+
+#ifndef MYRTOS_WORKQUEUE_H
+#define MYRTOS_WORKQUEUE_H
+
+#include "MyRTOS_Service_Config.h"
+
+
+#ifndef MYRTOS_SERVICE_WORKQUEUE_ENABLE
+#define MYRTOS_SERVICE_WORKQUEUE_ENABLE 0
+#endif
+
+
+#if MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
+
+#include <stdint.h>
+#include "MyRTOS.h"
+
+/** @brief 工作队列的优先级级别数 */
+#ifndef MYRTOS_WORKQUEUE_LEVELS
+#define MYRTOS_WORKQUEUE_LEVELS 2
+#endif
+
+/** @brief 每个级别的工作线程数 */
+#ifndef MYRTOS_WORKQUEUE_WORKERS_PER_LEVEL
+#define MYRTOS_WORKQUEUE_WORKERS_PER_LEVEL 1
+#endif
+
+/** @brief 级别0工作线程的任务优先级, 级别 i 的工作线程优先级为该值加 i */
+#ifndef MYRTOS_WORKQUEUE_BASE_PRIORITY
+#define MYRTOS_WORKQUEUE_BASE_PRIORITY 1
+#endif
+
+/** @brief 工作线程的栈大小 (字), 所有工作线程的栈都是静态分配的 */
+#ifndef MYRTOS_WORKQUEUE_STACK_SIZE
+#define MYRTOS_WORKQUEUE_STACK_SIZE 256
+#endif
+
+#if MYRTOS_WORKQUEUE_LEVELS < 1 || MYRTOS_WORKQUEUE_WORKERS_PER_LEVEL < 1
+#error "MYRTOS_WORKQUEUE_LEVELS and MYRTOS_WORKQUEUE_WORKERS_PER_LEVEL must be at least 1."
+#endif
+#if MYRTOS_WORKQUEUE_BASE_PRIORITY + MYRTOS_WORKQUEUE_LEVELS > MYRTOS_MAX_PRIORITIES
+#error "Work queue worker priorities exceed MYRTOS_MAX_PRIORITIES."
+#endif
+
+/** @brief 工作项状态 */
+typedef enum {
+    WORK_STATE_IDLE = 0, // 未提交, 或已执行完毕/已取消
+    WORK_STATE_DELAYED, // 已延迟提交, 等待到期
+    WORK_STATE_PENDING, // 已提交, 等待工作线程执行
+    WORK_STATE_RUNNING // 正在执行
+} WorkState_t;
+
+struct WorkItem_t;
+
+/**
+ * @brief 工作函数类型, 同时用作完成回调的类型
+ * @param item 工作项
+ * @param arg 工作项参数
+ */
+typedef void (*WorkFunc_t)(struct WorkItem_t *item, void *arg);
+
+/**
+ * @brief 工作项
+ * @details 由调用者提供存储, 用 WorkItem_Init 初始化。工作项在提交后、回到 WORK_STATE_IDLE 之前不能释放。
+ *          成员只由工作队列服务访问。
+ */
+typedef struct WorkItem_t {
+    WorkFunc_t func; // 工作函数
+    void *arg; // 工作函数参数
+    WorkFunc_t on_complete; // 完成回调, 在工作线程中紧接工作函数执行, 可为NULL
+    TaskHandle_t notify_task; // 完成时接收信号的任务, 可为NULL
+    uint32_t notify_signals; // 完成时发送的信号
+    struct WorkItem_t *next; // 所在链表的下一节点
+    struct WorkItem_t *prev; // 所在链表的上一节点
+    uint64_t expiry; // 延迟提交的到期时刻(Tick)
+    volatile uint8_t state; // 工作项状态, 取值同 WorkState_t
+    uint8_t level; // 所属级别
+} WorkItem_t;
+
+/**
+ * @brief 每个级别的统计信息
+ */
+typedef struct {
+    uint32_t submitted; // 进入待执行队列的次数
+    uint32_t executed; // 执行完成的次数
+    uint32_t cancelled; // 被取消的次数
+    uint32_t max_latency; // 进入待执行队列到开始执行的最大间隔 (Tick)
+} WorkQueueStats_t;
+
+/**
+ * @brief 初始化工作队列服务, 创建所有工作线程
+ * @return 0 成功, -1 失败
+ */
+int WorkQueue_Init(void);
+
+/**
+ * @brief 初始化工作项
+ * @param item 工作项存储
+ * @param func 工作函数
+ * @param arg 工作函数参数
+ * @param level 执行级别, 0 为最低, 超出范围时按最高级别处理
+ */
+void WorkItem_Init(WorkItem_t *item, WorkFunc_t func, void *arg, uint8_t level);
+
+/**
+ * @brief 设置工作项的完成通知
+ * @details 工作函数返回后, 先在工作线程中调用 on_complete, 工作项随后回到空闲状态,
+ *          最后向 notify_task 发送 notify_signals。被取消的工作项不会产生完成通知。
+ * @param item 工作项
+ * @param on_complete 完成回调, 可为NULL
+ * @param notify_task 接收完成信号的任务, 可为NULL
+ * @param notify_signals 完成信号
+ */
+void WorkItem_SetCompletion(WorkItem_t *item, WorkFunc_t on_complete, TaskHandle_t notify_task,
+                            uint32_t notify_signals);
+
+/**
+ * @brief 获取工作项的状态
+ */
+WorkState_t WorkItem_GetState(const WorkItem_t *item);
+
+/**
+ * @brief 提交工作项
+ * @details 已在待执行队列中的工作项保持原来的位置; 延迟中的工作项立即进入待执行队列;
+ *          正在执行的工作项会再执行一次 (同一级别有多个工作线程时, 两次执行可能重叠)。
+ * @param item 工作项
+ * @return 0 成功, -1 参数无效或服务未初始化
+ */
+int WorkQueue_Submit(WorkItem_t *item);
+
+/**
+ * @brief 在中断中提交工作项
+ * @param item 工作项
+ * @param higherPriorityTaskWoken [out] 唤醒了更高优先级的工作线程时置1, 否则置0; 可为NULL
+ * @return 0 成功, -1 参数无效或服务未初始化
+ */
+int WorkQueue_SubmitFromISR(WorkItem_t *item, int *higherPriorityTaskWoken);
+
+/**
+ * @brief 延迟提交工作项
+ * @details 工作项在 delay_ticks 之后进入待执行队列。已在队列中或延迟中的工作项按新的延迟重新安排。
+ * @param item 工作项
+ * @param delay_ticks 延迟的Tick数, 0 等同于 WorkQueue_Submit
+ * @return 0 成功, -1 参数无效或服务未初始化
+ */
+int WorkQueue_SubmitDelayed(WorkItem_t *item, uint32_t delay_ticks);
+
+/**
+ * @brief 取消尚未开始执行的工作项
+ * @param item 工作项
+ * @return 0 已从队列中移除, -1 工作项不在队列中 (空闲或正在执行)
+ */
+int WorkQueue_Cancel(WorkItem_t *item);
+
+/**
+ * @brief 获取一个级别的统计信息
+ * @param level 级别
+ * @param stats_out [out] 统计信息
+ * @return 0 成功, -1 级别无效
+ */
+int WorkQueue_GetStats(uint8_t level, WorkQueueStats_t *stats_out);
+
+#endif // MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
+
+#endif // MYRTOS_WORKQUEUE_H
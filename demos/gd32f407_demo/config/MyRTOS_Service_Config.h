@@ -29,6 +29,12 @@
 /** @brief 启用进程管理服务模块 */
 #define MYRTOS_SERVICE_PROCESS_ENABLE 1
 
+/** @brief 启用协程服务模块 (大量无栈协程共用一个宿主任务) */
+#define MYRTOS_SERVICE_COROUTINE_ENABLE 0
+
+/** @brief 启用工作队列服务模块 (按优先级分级的工作线程池, 其他服务可选择把后台工作交给它) */
+#define MYRTOS_SERVICE_WORKQUEUE_ENABLE 0
+
 
 /*==================================================================================================
  *                                    模块参数配置
@@ -51,6 +57,11 @@
 #define MYRTOS_ASYNCIO_TASK_STACK_SIZE      1024
 /** @brief 异步I/O后台任务的优先级。通常应设为较低优先级，避免抢占关键业务。*/
 #define MYRTOS_ASYNCIO_TASK_PRIORITY        2
+/** @brief 由工作队列执行写请求 (需启用工作队列服务)。1 = 不再创建专用的后台任务, 节省一个任务的栈和TCB;
+ *         写请求改在工作线程的栈上执行, MYRTOS_WORKQUEUE_STACK_SIZE 不得小于 MYRTOS_ASYNCIO_TASK_STACK_SIZE */
+#define MYRTOS_ASYNCIO_USE_WORKQUEUE        0
+/** @brief 执行写请求的工作队列级别。写请求可能阻塞在输出流上, 不要与延迟敏感的工作共用一个级别 */
+#define MYRTOS_ASYNCIO_WORK_LEVEL           0
 #endif
 
 
@@ -80,6 +91,24 @@
 #define MYRTOS_TIMER_COMMAND_QUEUE_SIZE 10
 #endif
 
+#if MYRTOS_SERVICE_COROUTINE_ENABLE == 1
+/** @brief 有协程以 CO_AWAIT 等待任意条件时, 宿主任务轮询的最长间隔 (Tick); 队列/信号量由观察者唤醒, 不轮询 */
+#define MYRTOS_COROUTINE_POLL_TICKS 1
+/** @brief 唤醒宿主任务使用的任务信号位, 不要与 VTS 等服务使用的信号冲突 */
+#define MYRTOS_COROUTINE_WAKE_SIGNAL (1UL << 31)
+#endif
+
+#if MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
+/** @brief 工作队列的优先级级别数。同一级别的工作项按提交顺序执行, 级别越高工作线程优先级越高 */
+#define MYRTOS_WORKQUEUE_LEVELS 2
+/** @brief 每个级别的工作线程数。大于1时同一级别的工作项可以并行执行, 一个阻塞的工作项不会挡住其他工作项 */
+#define MYRTOS_WORKQUEUE_WORKERS_PER_LEVEL 1
+/** @brief 级别0工作线程的任务优先级, 级别 i 的工作线程优先级为该值加 i */
+#define MYRTOS_WORKQUEUE_BASE_PRIORITY 2
+/** @brief 工作线程的栈大小 (字), 所有工作线程的TCB和栈都是静态分配的 */
+#define MYRTOS_WORKQUEUE_STACK_SIZE 512
+#endif
+
 #if MYRTOS_SERVICE_VTS_ENABLE == 1
 #define VTS_TASK_PRIORITY 5
 #define VTS_TASK_STACK_SIZE 256
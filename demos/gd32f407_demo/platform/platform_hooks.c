@@ -34,7 +34,11 @@ __attribute__((weak)) void Platform_CreateTasks_Hook(void) {
 __attribute__((weak)) void Platform_IdleTask_Hook(void *pv) {
     (void) pv;
     for (;;) {
+#if MYRTOS_USE_TICKLESS_IDLE == 1
+        MyRTOS_Idle_Sleep(); // 低功耗空闲: 停止 SysTick 直到最近的任务唤醒时间
+#else
         __WFI(); // 等待中断，进入低功耗模式
+#endif
     }
 }
 
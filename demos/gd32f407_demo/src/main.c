@@ -595,10 +595,15 @@ static int blinky_main(int argc, char *argv[]) {
     (void)argc;
     (void)argv;
 
+    // 按绝对的释放点计算等待时间, 闪烁周期不随调度延迟漂移
+    uint64_t next_wake = MyRTOS_GetTick();
     while (1) {
         gpio_bit_toggle(GPIOB, GPIO_PIN_2);
 
-        uint32_t signals = Task_WaitSignal(SIG_INTERRUPT, MS_TO_TICKS(1000),
+        next_wake += MS_TO_TICKS(1000);
+        uint64_t now = MyRTOS_GetTick();
+        uint32_t timeout = (next_wake > now) ? (uint32_t)(next_wake - now) : 0;
+        uint32_t signals = Task_WaitSignal(SIG_INTERRUPT, timeout,
                                           SIGNAL_WAIT_ANY | SIGNAL_CLEAR_ON_EXIT);
 
         if (signals & SIG_INTERRUPT) {
@@ -616,10 +621,11 @@ static int looper_main(int argc, char *argv[]) {
     (void) argv;
     int count = 0;
     const char *task_name = Task_GetName(NULL);
+    uint64_t last_wake = MyRTOS_GetTick();
     for (;;) {
         MyRTOS_printf("[looper BG via printf] This message should be SILENT in background. Count: %d\n", count);
         LOG_I(task_name, "Hello from background via LOG! Count: %d", ++count);
-        Task_Delay(MS_TO_TICKS(2000));
+        Task_DelayUntil(&last_wake, MS_TO_TICKS(2000));
     }
     return 0;
 }
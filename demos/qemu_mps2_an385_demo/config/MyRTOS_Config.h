@@ -27,19 +27,79 @@
 // 最大任务优先级数
 #define MYRTOS_MAX_PRIORITIES (32)
 
-// 系统支持的最大并发任务数
-#define MYRTOS_MAX_CONCURRENT_TASKS (64)
+// 系统支持的最大并发任务数 (bench tasks 需要同时创建 1024 个任务)
+#define MYRTOS_MAX_CONCURRENT_TASKS (1280)
 
 // 无限期阻塞等待的Tick计数值
 #define MYRTOS_MAX_DELAY (0xFFFFFFFFUL)
 
+// 新建任务默认的时间片长度 (单位: Tick), 0 表示同优先级任务之间不轮转
+#define MYRTOS_DEFAULT_TIME_SLICE (10)
+
+// 延迟任务时间轮每级的槽位数位宽 (槽位数 = 2^bits)
+#define MYRTOS_DELAY_WHEEL_BITS (6)
+
+// 低功耗空闲模式 (Tickless Idle)
+// 1 = 所有任务阻塞时停止周期性 SysTick, 休眠到最近的唤醒时间; 0 = 每个Tick都产生中断
+#define MYRTOS_USE_TICKLESS_IDLE 1
+
+// 进入低功耗空闲模式所需的最少空闲Tick数
+#define MYRTOS_TICKLESS_MIN_IDLE_TICKS (2)
+
+// 最早截止时间优先 (EDF) 调度类
+// 1 = MYRTOS_EDF_PRIORITY 上的任务按绝对截止时间调度; 0 = 只有固定优先级调度
+#define MYRTOS_USE_EDF 1
+
+// EDF 调度类占用的优先级, 该优先级只用于 Task_CreateEDF 创建的任务
+#define MYRTOS_EDF_PRIORITY (4)
+
+// 中断延迟调用 (下半部)
+// 1 = 中断可通过 MyRTOS_DeferFromISR 把工作交给高优先级守护任务执行; 0 = 禁用
+#define MYRTOS_USE_DEFERRED_CALL 1
+
+// 延迟调用队列长度 (必须是2的幂) 与统计的来源数
+#define MYRTOS_DEFERRED_QUEUE_LENGTH (32)
+#define MYRTOS_DEFERRED_MAX_SOURCES (8)
+
+// EventGroup_SetBitsFromISR 使用的延迟调用来源编号
+#define MYRTOS_EVENT_GROUP_DEFER_SOURCE (7)
+
+// CPU预算服务器
+// 1 = 可通过 Task_SetBudget 限制任务每个周期最多运行的Tick数; 0 = 禁用
+#define MYRTOS_USE_BUDGET 1
+
+// 同步原语快速路径
+// 1 = 无竞争的互斥锁/信号量操作用 LDREX/STREX 完成, 不进入临界区; 0 = 总是进入临界区
+#define MYRTOS_USE_SYNC_FAST_PATH 1
+
+// 优先级继承沿互斥锁链传递的最大深度
+#define MYRTOS_MUTEX_INHERIT_DEPTH (8)
+
+// 可调用内核 FromISR API 的最高中断优先级 (未移位的 NVIC 优先级, 数值越小优先级越高)
+// 临界区通过 BASEPRI 只屏蔽该优先级及更低的中断, 优先级数值更小的中断不受内核影响;
+// 0 = 临界区关闭全部中断 (PRIMASK)
+#define MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY (4)
+
 /*===========================================================================*
  *                      内存配置                                              *
  *===========================================================================*/
 
+// 是否启用内核内存堆; 0 = 只能使用 *_CreateStatic 创建内核对象 (服务模块需要内存堆)
+#define MYRTOS_USE_HEAP 1
+
+// 空闲任务的静态栈大小 (字)
+#define MYRTOS_IDLE_TASK_STACK (128)
+
+// 创建任务时填充栈以统计栈高水位 (1 = 启用)
+#define MYRTOS_TASK_STACK_PAINT 1
+
+// Flash 地址范围, 位于其中的任务名 (字符串常量) 直接引用而不复制
+#define MYRTOS_ROM_START (0x00000000UL)
+#define MYRTOS_ROM_END (0x00400000UL)
+
 // RTOS内核管理的内存堆大小 (单位: 字节)
 // QEMU 模拟的 MPS2-AN385 有 4MB RAM
-#define MYRTOS_MEMORY_POOL_SIZE (256 * 1024)
+#define MYRTOS_MEMORY_POOL_SIZE (1024 * 1024)
 
 // 内存分配的对齐字节数
 #define MYRTOS_HEAP_BYTE_ALIGNMENT (8)
@@ -48,12 +108,12 @@
  *                         配置错误检查                                       *
  *===========================================================================*/
 
-#if MYRTOS_MAX_PRIORITIES > 32
-#error "MY_RTOS_MAX_PRIORITIES must be less than or equal to 32."
+#if MYRTOS_MAX_PRIORITIES > 256
+#error "MYRTOS_MAX_PRIORITIES must be less than or equal to 256."
 #endif
 
-#if MYRTOS_MAX_CONCURRENT_TASKS > 64
-#error "MYRTOS_MAX_CONCURRENT_TASKS must be less than or equal to 64."
+#if MYRTOS_MAX_CONCURRENT_TASKS > 65535
+#error "MYRTOS_MAX_CONCURRENT_TASKS must be less than or equal to 65535."
 #endif
 
 #if (MYRTOS_CPU_CLOCK_HZ / MYRTOS_TICK_RATE_HZ) > 0xFFFFFF
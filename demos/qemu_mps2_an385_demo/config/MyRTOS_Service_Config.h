@@ -32,6 +32,12 @@
 /** @brief 启用进程管理服务模块 */
 #define MYRTOS_SERVICE_PROCESS_ENABLE       1
 
+/** @brief 启用协程服务模块 */
+#define MYRTOS_SERVICE_COROUTINE_ENABLE     1
+
+/** @brief 启用工作队列服务模块 */
+#define MYRTOS_SERVICE_WORKQUEUE_ENABLE     1
+
 /*===========================================================================*
  *                      模块参数配置                                          *
  *===========================================================================*/
@@ -54,6 +60,10 @@
 #define MYRTOS_ASYNCIO_TASK_STACK_SIZE      1024
 /** @brief 异步I/O后台任务的优先级 */
 #define MYRTOS_ASYNCIO_TASK_PRIORITY        2
+/** @brief 由工作队列执行写请求, 不再创建后台任务 */
+#define MYRTOS_ASYNCIO_USE_WORKQUEUE        1
+/** @brief 执行写请求的工作队列级别 */
+#define MYRTOS_ASYNCIO_WORK_LEVEL           0
 #endif
 
 #if MYRTOS_SERVICE_LOG_ENABLE == 1
@@ -75,6 +85,21 @@
 #define MYRTOS_TIMER_COMMAND_QUEUE_SIZE     10
 #endif
 
+#if MYRTOS_SERVICE_COROUTINE_ENABLE == 1
+/** @brief 有协程以 CO_AWAIT 等待任意条件时, 宿主任务轮询的最长间隔 (Tick); 队列/信号量由观察者唤醒, 不轮询 */
+#define MYRTOS_COROUTINE_POLL_TICKS         1
+#endif
+
+#if MYRTOS_SERVICE_WORKQUEUE_ENABLE == 1
+/** @brief 工作队列的优先级级别数与每级工作线程数 */
+#define MYRTOS_WORKQUEUE_LEVELS             2
+#define MYRTOS_WORKQUEUE_WORKERS_PER_LEVEL  1
+/** @brief 级别0工作线程的优先级, 级别 i 为该值加 i */
+#define MYRTOS_WORKQUEUE_BASE_PRIORITY      2
+/** @brief 工作线程的栈大小 (字), 由工作队列执行异步I/O写请求时不得小于 MYRTOS_ASYNCIO_TASK_STACK_SIZE */
+#define MYRTOS_WORKQUEUE_STACK_SIZE         1024
+#endif
+
 #if MYRTOS_SERVICE_VTS_ENABLE == 1
 #define VTS_TASK_PRIORITY                   5
 #define VTS_TASK_STACK_SIZE                 256
@@ -27,6 +27,9 @@ extern "C" {
 #define PLATFORM_USE_HIRES_TIMER    1
 #define PLATFORM_HIRES_TIMER_NUM    0
 
+// 中断延迟调用的来源编号 (用于 MyRTOS_DeferFromISR 的分类统计)
+#define PLATFORM_DEFER_SOURCE_UART0 0
+
 // ============================================================================
 //                           错误处理动作定义
 // ============================================================================
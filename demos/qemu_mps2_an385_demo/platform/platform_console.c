@@ -60,6 +60,16 @@ static int uart_getchar_nonblock(void) {
 //                           中断处理
 // ============================================================================
 
+#if MYRTOS_USE_DEFERRED_CALL == 1
+/**
+ * @brief UART0 接收中断的下半部, 在延迟调用守护任务中执行
+ */
+static void uart_rx_deferred(void *arg) {
+    (void)arg;
+    Semaphore_Give(s_rx_semaphore);
+}
+#endif
+
 /**
  * @brief UART0 中断处理函数
  */
@@ -74,9 +84,14 @@ void UART0_Handler(void) {
 
         // 通知接收信号量
         if (s_rx_semaphore) {
+#if MYRTOS_USE_DEFERRED_CALL == 1
+            // 释放信号量需要操作内核链表, 交给延迟调用守护任务完成, 中断本身不进入临界区
+            MyRTOS_DeferFromISR(PLATFORM_DEFER_SOURCE_UART0, uart_rx_deferred, NULL);
+#else
             int woken = 0;
             Semaphore_GiveFromISR(s_rx_semaphore, &woken);
             MyRTOS_Port_YieldFromISR(woken);
+#endif
         }
     }
 }
@@ -75,5 +75,9 @@ static void platform_kernel_event_handler(const KernelEventData_t *pEventData) {
  *        应在内核初始化后调用
  */
 void Platform_ErrorHandler_Init(void) {
-    MyRTOS_RegisterExtension(platform_kernel_event_handler);
+    MyRTOS_RegisterExtension(platform_kernel_event_handler,
+                             KERNEL_EVENT_MASK(KERNEL_EVENT_HOOK_STACK_OVERFLOW) |
+                             KERNEL_EVENT_MASK(KERNEL_EVENT_HOOK_MALLOC_FAILED) |
+                             KERNEL_EVENT_MASK(KERNEL_EVENT_ERROR_HARD_FAULT) |
+                             KERNEL_EVENT_MASK(KERNEL_EVENT_ERROR_TASK_RETURN));
 }
@@ -54,7 +54,11 @@ __attribute__((weak))
 void Platform_IdleTask_Hook(void *pv) {
     (void)pv;
     for (;;) {
+#if MYRTOS_USE_TICKLESS_IDLE == 1
+        MyRTOS_Idle_Sleep();  // 低功耗空闲: 跳过无事可做的Tick
+#else
         __WFI();  // 等待中断
+#endif
     }
 }
 
@@ -0,0 +1,1053 @@
+/**
+ * @brief MyRTOS QEMU MPS2-AN385 内核性能测量程序
+ * @note  通过 shell 运行: bench <子命令> [参数]
+ *        计时基于 TIMER0 (25MHz, 与 CPU 主频一致, 单位可视为时钟周期)。
+ *        QEMU 默认使用宿主机时钟, 建议以 `-icount shift=0` 启动以获得可重复的结果。
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "MyRTOS.h"
+#include "MyRTOS_Coroutine.h"
+#include "MyRTOS_Extension.h"
+#include "MyRTOS_Port.h"
+#include "platform.h"
+
+#if MYRTOS_SERVICE_PROCESS_ENABLE == 1
+#include "MyRTOS_Process.h"
+#if MYRTOS_SERVICE_MONITOR_ENABLE == 1
+#include "MyRTOS_Monitor.h"
+#endif
+
+// ============================================================================
+//                           配置
+// ============================================================================
+// 测量任务的优先级: 高于 demo 中的业务任务, 低于定时器服务
+#define BENCH_TASK_PRIO (MYRTOS_MAX_PRIORITIES - 3)
+// 测量任务的栈大小 (字)
+#define BENCH_TASK_STACK 128
+// 每组测量的上下文切换总次数
+#define BENCH_SWITCH_ROUNDS 20000
+// 规模测试中任务的优先级: 低于进程启动器 (MYRTOS_PROCESS_LAUNCHER_PRIORITY), 创建过程中不会被新任务抢占
+#define BENCH_SCALE_PRIO 1
+// 规模测试中任务的栈大小 (字)
+#define BENCH_SCALE_STACK 96
+// 反复创建/删除测试的默认轮数
+#define BENCH_SPAWN_ROUNDS 1000
+// bench tick 的默认调用次数
+#define BENCH_TICK_ROUNDS 10000
+// 抢占阈值测试: 默认传递的产品数, 队列长度与 demo 中的产品队列相同
+#define BENCH_PT_ITEMS 10000
+#define BENCH_PT_QUEUE_LENGTH 3
+// 抢占阈值测试中生产者和消费者的优先级: 与 demo 中的生产者和质检员一样, 接收方优先级更高
+#define BENCH_PT_PRODUCER_PRIO (BENCH_TASK_PRIO - 1)
+#define BENCH_PT_CONSUMER_PRIO BENCH_TASK_PRIO
+// bench lock 的默认获取/释放次数
+#define BENCH_LOCK_ROUNDS 10000
+// bench lock 嵌套测量中外层互斥锁的数量
+#define BENCH_LOCK_NESTING 4
+// bench lock 中天花板互斥锁的天花板: 不低于任何可能运行 bench 的任务的优先级
+#define BENCH_LOCK_CEILING (MYRTOS_MAX_PRIORITIES - 1)
+// bench event 的默认通知轮数与等待者数量上限
+#define BENCH_EVENT_ROUNDS 1000
+#define BENCH_EVENT_MAX_WAITERS 32
+// bench event 中等待者等待的事件位
+#define BENCH_EVENT_BIT (1UL << 0)
+// EDF 测试的运行时长 (ms)
+#define BENCH_EDF_DURATION_MS 2000
+// 两次读取计时器之间的间隔超过该值 (周期) 即视为被抢占, 不计入自身的执行时间
+#define BENCH_EDF_PREEMPT_GAP 2000
+// 中断延迟测试中 TIMER1 的中断周期 (周期数, 25MHz 下为 100us)
+#define BENCH_IRQ_PERIOD 2500
+// 中断延迟测试每一档优先级的运行时长 (ms)
+#define BENCH_IRQ_DURATION_MS 1000
+// 中断延迟测试中负载任务的优先级: 低于进程启动器, 测量结束时调用者能按时醒来
+#define BENCH_IRQ_LOAD_PRIO 1
+// 中断延迟测试中负载任务每一轮显式临界区的长度 (周期数, 25MHz 下为 20us)
+#define BENCH_IRQ_CRITICAL_CYCLES 500
+
+// ============================================================================
+//                           私有变量
+// ============================================================================
+static volatile uint32_t g_switch_count;
+static volatile uint32_t g_switch_target;
+static volatile uint32_t g_switch_start;
+static volatile uint32_t g_switch_end;
+static volatile uint8_t g_switch_go;
+static volatile uint8_t g_switch_started;
+static volatile uint32_t g_scale_ran;
+static volatile uint32_t g_scale_target;
+static volatile uint32_t g_scale_end;
+
+// ============================================================================
+//                           计时辅助
+// ============================================================================
+
+static inline uint32_t bench_now(void) {
+    return Platform_Timer_GetHiresValue();
+}
+
+// TIMER0 为递减计数器, 起点减终点即为经过的计数值
+static inline uint32_t bench_elapsed(uint32_t start, uint32_t end) {
+    return start - end;
+}
+
+// ============================================================================
+//                           bench switch
+// ============================================================================
+
+/**
+ * @brief 同优先级轮转的测量任务
+ *        所有任务先等待启动标志, 随后交替让出 CPU, 每次让出即一次上下文切换。
+ */
+static void switch_worker(void *param) {
+    (void) param;
+    while (!g_switch_go) {
+        Task_Delay(1);
+    }
+    if (!g_switch_started) {
+        g_switch_started = 1;
+        g_switch_start = bench_now();
+    }
+    while (g_switch_count < g_switch_target) {
+        if (++g_switch_count == g_switch_target) {
+            g_switch_end = bench_now();
+        }
+        Task_Yield();
+    }
+    // 测量结束, 等待被删除
+    for (;;) {
+        Task_Wait();
+    }
+}
+
+static int bench_switch_run(uint32_t task_count) {
+    TaskHandle_t tasks[64];
+    uint32_t created = 0;
+
+    g_switch_count = 0;
+    g_switch_target = BENCH_SWITCH_ROUNDS;
+    g_switch_go = 0;
+    g_switch_started = 0;
+    for (; created < task_count; created++) {
+        tasks[created] = Task_Create(switch_worker, "bench_sw", BENCH_TASK_STACK, NULL, BENCH_TASK_PRIO);
+        if (tasks[created] == NULL) {
+            break;
+        }
+    }
+    if (created == task_count) {
+        g_switch_go = 1;
+        while (g_switch_count < g_switch_target) {
+            Task_Delay(MS_TO_TICKS(10));
+        }
+        uint32_t cycles = bench_elapsed(g_switch_start, g_switch_end);
+        MyRTOS_printf("  %2lu tasks: %8lu cycles / %lu switches = %5lu cycles/switch\n", task_count, cycles,
+                      g_switch_target, cycles / g_switch_target);
+    } else {
+        MyRTOS_printf("  %2lu tasks: create failed (heap exhausted?)\n", task_count);
+    }
+    for (uint32_t i = 0; i < created; i++) {
+        Task_Delete(tasks[i]);
+    }
+    return created == task_count ? 0 : -1;
+}
+
+/**
+ * @brief 测量同一优先级下 2~64 个任务轮转时的单次上下文切换开销
+ */
+static int bench_switch(int argc, char *argv[]) {
+    static const uint32_t counts[] = {2, 4, 8, 16, 32, 64};
+    MyRTOS_printf("Context switch cost, %d tasks at priority %d:\n", BENCH_SWITCH_ROUNDS, BENCH_TASK_PRIO);
+    if (argc > 1) {
+        uint32_t n = (uint32_t) atoi(argv[1]);
+        if (n < 2 || n > 64) {
+            MyRTOS_printf("Task count must be in [2, 64].\n");
+            return -1;
+        }
+        return bench_switch_run(n);
+    }
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        if (bench_switch_run(counts[i]) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+//                           bench co
+// ============================================================================
+#if MYRTOS_SERVICE_COROUTINE_ENABLE == 1
+
+static volatile uint32_t g_co_count;
+static volatile uint32_t g_co_target;
+static volatile uint32_t g_co_start;
+static volatile uint32_t g_co_end;
+static volatile uint8_t g_co_started;
+
+/**
+ * @brief 协程轮转测量: 所有协程在同一宿主任务中交替让出, 每次让出即一次协程切换
+ */
+static CoStatus_t co_worker(Coroutine_t *co, void *arg) {
+    (void) arg;
+    CO_BEGIN(co);
+    if (!g_co_started) {
+        g_co_started = 1;
+        g_co_start = bench_now();
+    }
+    while (g_co_count < g_co_target) {
+        if (++g_co_count == g_co_target) {
+            g_co_end = bench_now();
+        }
+        CO_YIELD(co);
+    }
+    CO_END(co);
+}
+
+static int bench_co_run(uint32_t co_count) {
+    static CoScheduler_t sched;
+    Coroutine_t *cos = MyRTOS_Malloc(co_count * sizeof(Coroutine_t));
+    if (cos == NULL) {
+        MyRTOS_printf("  %4lu coroutines: out of memory\n", co_count);
+        return -1;
+    }
+    memset(cos, 0, co_count * sizeof(Coroutine_t));
+    g_co_count = 0;
+    g_co_target = BENCH_SWITCH_ROUNDS;
+    g_co_started = 0;
+    CoScheduler_Init(&sched);
+    for (uint32_t i = 0; i < co_count; i++) {
+        Coroutine_Start(&sched, &cos[i], "bench_co", co_worker, NULL);
+    }
+    // 宿主任务优先级高于当前任务, 创建后立即运行全部协程
+    TaskHandle_t host = Task_Create(CoScheduler_Task, "bench_co", BENCH_TASK_STACK, &sched, BENCH_TASK_PRIO);
+    if (host == NULL) {
+        MyRTOS_printf("  %4lu coroutines: create host task failed\n", co_count);
+        MyRTOS_Free(cos);
+        return -1;
+    }
+    while (sched.count != 0) {
+        Task_Delay(MS_TO_TICKS(10));
+    }
+    uint32_t cycles = bench_elapsed(g_co_start, g_co_end);
+    MyRTOS_printf("  %4lu coroutines: %8lu cycles / %lu switches = %5lu cycles/switch, %5lu bytes\n", co_count,
+                  cycles, g_co_target, cycles / g_co_target, (unsigned long) (co_count * sizeof(Coroutine_t)));
+    Task_Delete(host);
+    MyRTOS_Free(cos);
+    return 0;
+}
+
+/**
+ * @brief 测量单个宿主任务中 n 个协程轮转的切换开销和内存占用, 与 bench switch 对照
+ */
+static int bench_co(int argc, char *argv[]) {
+    static const uint32_t counts[] = {2, 64, 1024};
+    MyRTOS_printf("Coroutine switch cost, %d switches in one host task at priority %d:\n", BENCH_SWITCH_ROUNDS,
+                  BENCH_TASK_PRIO);
+    MyRTOS_printf("  per coroutine %lu bytes; per task %lu bytes (TCB + %d-word stack)\n",
+                  (unsigned long) sizeof(Coroutine_t),
+                  (unsigned long) (sizeof(StaticTask_t) + BENCH_TASK_STACK * sizeof(StackType_t)), BENCH_TASK_STACK);
+    if (argc > 1) {
+        uint32_t n = (uint32_t) atoi(argv[1]);
+        if (n < 1) {
+            MyRTOS_printf("Coroutine count must be positive.\n");
+            return -1;
+        }
+        return bench_co_run(n);
+    }
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        if (bench_co_run(counts[i]) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+#endif /* MYRTOS_SERVICE_COROUTINE_ENABLE */
+
+// ============================================================================
+//                           bench tasks
+// ============================================================================
+
+/**
+ * @brief 规模测试任务: 运行一次后阻塞, 最后一个运行的任务记录结束时间
+ */
+static void scale_worker(void *param) {
+    (void) param;
+    if (++g_scale_ran == g_scale_target) {
+        g_scale_end = bench_now();
+    }
+    for (;;) {
+        Task_Wait();
+    }
+}
+
+static int bench_tasks_run(uint32_t task_count) {
+    TaskHandle_t *tasks = MyRTOS_Malloc(task_count * sizeof(TaskHandle_t));
+    if (tasks == NULL) {
+        MyRTOS_printf("  %4lu tasks: out of memory\n", task_count);
+        return -1;
+    }
+    uint32_t created = 0;
+    g_scale_ran = 0;
+    g_scale_target = task_count;
+
+    // 创建: 新任务优先级低于当前任务, 全部创建完之前不会运行
+    uint32_t start = bench_now();
+    for (; created < task_count; created++) {
+        tasks[created] = Task_Create(scale_worker, "bench_sc", BENCH_SCALE_STACK, NULL, BENCH_SCALE_PRIO);
+        if (tasks[created] == NULL) {
+            break;
+        }
+    }
+    uint32_t create_cycles = bench_elapsed(start, bench_now());
+
+    int result = -1;
+    if (created == task_count) {
+        // 运行: 当前任务阻塞后, 每个新任务各被调度一次
+        start = bench_now();
+        while (g_scale_ran < task_count) {
+            Task_Delay(1);
+        }
+        uint32_t run_cycles = bench_elapsed(start, g_scale_end);
+
+        // 删除
+        start = bench_now();
+        for (uint32_t i = 0; i < created; i++) {
+            Task_Delete(tasks[i]);
+        }
+        uint32_t delete_cycles = bench_elapsed(start, bench_now());
+        created = 0;
+
+        MyRTOS_printf("  %4lu tasks: create %6lu  run %6lu  delete %6lu cycles/task\n", task_count,
+                      create_cycles / task_count, run_cycles / task_count, delete_cycles / task_count);
+        result = 0;
+    } else {
+        MyRTOS_printf("  %4lu tasks: create failed at %lu (heap or task slots exhausted?)\n", task_count, created);
+    }
+    for (uint32_t i = 0; i < created; i++) {
+        Task_Delete(tasks[i]);
+    }
+    MyRTOS_Free(tasks);
+    return result;
+}
+
+/**
+ * @brief 测量 64/256/1024 个任务规模下创建、首次运行和删除的单任务开销
+ */
+static int bench_tasks(int argc, char *argv[]) {
+    static const uint32_t counts[] = {64, 256, 1024};
+    MyRTOS_printf("Task create/run/delete cost, priority %d, stack %d words:\n", BENCH_SCALE_PRIO,
+                  BENCH_SCALE_STACK);
+    if (argc > 1) {
+        uint32_t n = (uint32_t) atoi(argv[1]);
+        if (n < 1 || n > MYRTOS_MAX_CONCURRENT_TASKS) {
+            MyRTOS_printf("Task count must be in [1, %d].\n", MYRTOS_MAX_CONCURRENT_TASKS);
+            return -1;
+        }
+        return bench_tasks_run(n);
+    }
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        if (bench_tasks_run(counts[i]) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+//                           bench spawn
+// ============================================================================
+
+static void spawn_worker(void *param) {
+    (void) param;
+    for (;;) {
+        Task_Wait();
+    }
+}
+
+static int bench_spawn_run(uint32_t rounds, const char *name, const char *label) {
+    uint32_t create_total = 0, create_max = 0;
+    uint32_t delete_total = 0, delete_max = 0;
+    for (uint32_t i = 0; i < rounds; i++) {
+        // 新任务优先级低于当前任务, 创建后不会运行, 只测量创建和删除本身
+        uint32_t start = bench_now();
+        TaskHandle_t task = Task_Create(spawn_worker, name, BENCH_TASK_STACK, NULL, BENCH_SCALE_PRIO);
+        uint32_t cycles = bench_elapsed(start, bench_now());
+        if (task == NULL) {
+            MyRTOS_printf("  create failed at round %lu\n", i);
+            return -1;
+        }
+        create_total += cycles;
+        if (cycles > create_max) {
+            create_max = cycles;
+        }
+        start = bench_now();
+        Task_Delete(task);
+        cycles = bench_elapsed(start, bench_now());
+        delete_total += cycles;
+        if (cycles > delete_max) {
+            delete_max = cycles;
+        }
+    }
+    MyRTOS_printf("  %-16s create avg %5lu max %6lu  delete avg %5lu max %6lu cycles\n", label,
+                  create_total / rounds, create_max, delete_total / rounds, delete_max);
+    return 0;
+}
+
+/**
+ * @brief 反复创建并删除同一个任务, 模拟 Process_Create 的任务生成路径
+ *        分别使用字符串常量 (只读存储中, 直接引用) 和栈上的任务名 (需要复制)。
+ */
+static int bench_spawn(int argc, char *argv[]) {
+    uint32_t rounds = BENCH_SPAWN_ROUNDS;
+    if (argc > 1) {
+        rounds = (uint32_t) atoi(argv[1]);
+        if (rounds < 1) {
+            MyRTOS_printf("Round count must be at least 1.\n");
+            return -1;
+        }
+    }
+    char copied_name[16];
+    strcpy(copied_name, "bench_spawn");
+    MyRTOS_printf("Task spawn cost, %lu rounds, stack %d words, stack paint %d:\n", rounds, BENCH_TASK_STACK,
+                  MYRTOS_TASK_STACK_PAINT);
+    if (bench_spawn_run(rounds, "bench_spawn", "const name") != 0) {
+        return -1;
+    }
+    return bench_spawn_run(rounds, copied_name, "copied name");
+}
+
+// ============================================================================
+//                           bench pt
+// ============================================================================
+
+// 与 demo 中产品队列的消息相同
+typedef struct {
+    uint32_t id;
+    uint32_t data;
+} BenchProduct_t;
+
+static QueueHandle_t g_pt_queue;
+static volatile uint32_t g_pt_items;
+static volatile uint32_t g_pt_consumed;
+static volatile uint32_t g_pt_switches;
+static volatile uint32_t g_pt_start;
+static volatile uint32_t g_pt_end;
+static volatile uint8_t g_pt_go;
+static volatile uint8_t g_pt_counting;
+static TaskHandle_t g_pt_last_task;
+
+/**
+ * @brief 统计实际发生的上下文切换 (切入的任务与上一次不同)
+ */
+static void pt_switch_hook(const KernelEventData_t *pEventData) {
+    if (g_pt_counting && pEventData->task != g_pt_last_task) {
+        g_pt_switches++;
+    }
+    g_pt_last_task = pEventData->task;
+}
+
+static void pt_producer(void *param) {
+    (void) param;
+    BenchProduct_t product = {0, 100};
+    while (!g_pt_go) {
+        Task_Delay(1);
+    }
+    g_pt_switches = 0;
+    g_pt_start = bench_now();
+    g_pt_counting = 1;
+    for (uint32_t i = 0; i < g_pt_items; i++) {
+        product.id++;
+        product.data += 10;
+        Queue_Send(g_pt_queue, &product, MYRTOS_MAX_DELAY);
+    }
+    for (;;) {
+        Task_Wait();
+    }
+}
+
+static void pt_consumer(void *param) {
+    (void) param;
+    BenchProduct_t product;
+    for (;;) {
+        if (Queue_Receive(g_pt_queue, &product, MYRTOS_MAX_DELAY) == 1 && ++g_pt_consumed == g_pt_items) {
+            g_pt_counting = 0;
+            g_pt_end = bench_now();
+        }
+    }
+}
+
+static int bench_pt_run(uint32_t items, uint8_t threshold, const char *label) {
+    g_pt_items = items;
+    g_pt_consumed = 0;
+    g_pt_go = 0;
+    g_pt_counting = 0;
+    g_pt_queue = Queue_Create(BENCH_PT_QUEUE_LENGTH, sizeof(BenchProduct_t));
+    TaskHandle_t consumer = Task_Create(pt_consumer, "bench_cons", BENCH_TASK_STACK, NULL, BENCH_PT_CONSUMER_PRIO);
+    TaskHandle_t producer = Task_Create(pt_producer, "bench_prod", BENCH_TASK_STACK, NULL, BENCH_PT_PRODUCER_PRIO);
+    int result = -1;
+    if (g_pt_queue != NULL && consumer != NULL && producer != NULL &&
+        Task_SetPreemptionThreshold(producer, threshold) == 0) {
+        g_pt_go = 1;
+        while (g_pt_consumed < items) {
+            Task_Delay(MS_TO_TICKS(10));
+        }
+        const uint32_t cycles = bench_elapsed(g_pt_start, g_pt_end);
+        MyRTOS_printf("  %-20s %7lu switches (%3lu.%02lu per item)  %6lu cycles/item\n", label, g_pt_switches,
+                      g_pt_switches / items, (g_pt_switches % items) * 100 / items, cycles / items);
+        result = 0;
+    } else {
+        MyRTOS_printf("  %-20s setup failed (heap exhausted?)\n", label);
+    }
+    if (producer != NULL) {
+        Task_Delete(producer);
+    }
+    if (consumer != NULL) {
+        Task_Delete(consumer);
+    }
+    if (g_pt_queue != NULL) {
+        Queue_Delete(g_pt_queue);
+    }
+    return result;
+}
+
+/**
+ * @brief 在 demo 的生产者/消费者模型上比较有无抢占阈值时的上下文切换次数
+ *        消费者优先级高于生产者, 普通抢占下每个产品都会引起两次切换;
+ *        把生产者的抢占阈值提高到消费者的优先级后, 生产者先填满队列, 消费者再一次取完。
+ */
+static int bench_pt(int argc, char *argv[]) {
+    uint32_t items = BENCH_PT_ITEMS;
+    if (argc > 1) {
+        items = (uint32_t) atoi(argv[1]);
+        if (items < 1) {
+            MyRTOS_printf("Item count must be at least 1.\n");
+            return -1;
+        }
+    }
+    if (MyRTOS_RegisterExtension(pt_switch_hook, KERNEL_EVENT_MASK(KERNEL_EVENT_TASK_SWITCH_IN)) != 0) {
+        MyRTOS_printf("No free kernel extension slot.\n");
+        return -1;
+    }
+    MyRTOS_printf("Producer/consumer, %lu items, queue length %d, producer prio %d, consumer prio %d:\n", items,
+                  BENCH_PT_QUEUE_LENGTH, BENCH_PT_PRODUCER_PRIO, BENCH_PT_CONSUMER_PRIO);
+    int result = bench_pt_run(items, BENCH_PT_PRODUCER_PRIO, "strict preemption");
+    if (result == 0) {
+        result = bench_pt_run(items, BENCH_PT_CONSUMER_PRIO, "threshold = consumer");
+    }
+    MyRTOS_UnregisterExtension(pt_switch_hook);
+    return result;
+}
+
+// ============================================================================
+//                           bench tick
+// ============================================================================
+
+/**
+ * @brief 测量读取系统滴答计数的开销
+ *        "critical" 在读取外面再包一层临界区, 对应旧的关中断读取方式, 作为对照。
+ */
+static int bench_tick(int argc, char *argv[]) {
+    uint32_t rounds = BENCH_TICK_ROUNDS;
+    if (argc > 1) {
+        rounds = (uint32_t) atoi(argv[1]);
+        if (rounds < 1) {
+            MyRTOS_printf("Round count must be at least 1.\n");
+            return -1;
+        }
+    }
+    volatile uint64_t sink64 = 0;
+    volatile uint32_t sink32 = 0;
+    MyRTOS_printf("Tick read cost, %lu calls:\n", rounds);
+
+    uint32_t start = bench_now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        MyRTOS_Port_EnterCritical();
+        sink64 = MyRTOS_GetTick();
+        MyRTOS_Port_ExitCritical();
+    }
+    uint32_t cycles = bench_elapsed(start, bench_now());
+    MyRTOS_printf("  %-16s %5lu cycles/call\n", "critical", cycles / rounds);
+
+    start = bench_now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        sink64 = MyRTOS_GetTick();
+    }
+    cycles = bench_elapsed(start, bench_now());
+    MyRTOS_printf("  %-16s %5lu cycles/call\n", "GetTick", cycles / rounds);
+
+    start = bench_now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        sink32 = MyRTOS_GetTick32();
+    }
+    cycles = bench_elapsed(start, bench_now());
+    MyRTOS_printf("  %-16s %5lu cycles/call\n", "GetTick32", cycles / rounds);
+    (void) sink64;
+    (void) sink32;
+    return 0;
+}
+
+// ============================================================================
+//                           bench lock
+// ============================================================================
+
+/**
+ * @brief 测量一个互斥锁 rounds 次获取/释放的平均开销
+ * @param outer 测量前先按顺序获取的外层互斥锁, 模拟嵌套加锁
+ * @return 每对获取/释放的周期数
+ */
+static uint32_t bench_mutex_pairs(MutexHandle_t mutex, MutexHandle_t *outer, uint32_t outer_count, uint32_t rounds) {
+    for (uint32_t i = 0; i < outer_count; i++) {
+        Mutex_Lock(outer[i]);
+    }
+    const uint32_t start = bench_now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        Mutex_Lock(mutex);
+        Mutex_Unlock(mutex);
+    }
+    const uint32_t cycles = bench_elapsed(start, bench_now());
+    for (uint32_t i = outer_count; i > 0; i--) {
+        Mutex_Unlock(outer[i - 1]);
+    }
+    return cycles / rounds;
+}
+
+/**
+ * @brief 测量无竞争时互斥锁和信号量一次获取/释放的开销
+ *        "critical" 只进出一次临界区, 是临界区路径的开销下限, 作为对照;
+ *        关闭 MYRTOS_USE_SYNC_FAST_PATH 重新编译即可得到临界区路径的实际开销。
+ *        优先级继承互斥锁与天花板互斥锁分别在不嵌套和嵌套在 BENCH_LOCK_NESTING 把同类锁之内时测量。
+ */
+static int bench_lock(int argc, char *argv[]) {
+    uint32_t rounds = BENCH_LOCK_ROUNDS;
+    if (argc > 1) {
+        rounds = (uint32_t) atoi(argv[1]);
+        if (rounds < 1) {
+            MyRTOS_printf("Round count must be at least 1.\n");
+            return -1;
+        }
+    }
+    static StaticMutex_t inherit_buffers[BENCH_LOCK_NESTING + 1];
+    static StaticMutex_t ceiling_buffers[BENCH_LOCK_NESTING + 1];
+    static StaticSemaphore_t sem_buffer;
+    MutexHandle_t inherit[BENCH_LOCK_NESTING + 1];
+    MutexHandle_t ceiling[BENCH_LOCK_NESTING + 1];
+    for (uint32_t i = 0; i <= BENCH_LOCK_NESTING; i++) {
+        inherit[i] = Mutex_CreateStatic(&inherit_buffers[i]);
+        ceiling[i] = Mutex_CreateCeilingStatic(&ceiling_buffers[i], BENCH_LOCK_CEILING);
+    }
+    SemaphoreHandle_t sem = Semaphore_CreateStatic(1, 1, &sem_buffer);
+    if (sem == NULL || inherit[0] == NULL || ceiling[0] == NULL) {
+        MyRTOS_printf("  create failed\n");
+        return -1;
+    }
+#if MYRTOS_USE_SYNC_FAST_PATH == 1 && defined(MYRTOS_PORT_HAS_EXCLUSIVE)
+    const char *path = "LDREX/STREX fast path";
+#else
+    const char *path = "critical section";
+#endif
+    MyRTOS_printf("Uncontended lock/unlock pair, %lu rounds (%s):\n", rounds, path);
+
+    uint32_t start = bench_now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        MyRTOS_Port_EnterCritical();
+        MyRTOS_Port_ExitCritical();
+    }
+    uint32_t cycles = bench_elapsed(start, bench_now());
+    MyRTOS_printf("  %-20s %5lu cycles/pair\n", "critical", cycles / rounds);
+
+    MyRTOS_printf("  %-20s %5lu cycles/pair\n", "mutex (inherit)", bench_mutex_pairs(inherit[0], NULL, 0, rounds));
+    MyRTOS_printf("  %-20s %5lu cycles/pair\n", "mutex (ceiling)", bench_mutex_pairs(ceiling[0], NULL, 0, rounds));
+    MyRTOS_printf("  %-20s %5lu cycles/pair\n", "nested (inherit)",
+                  bench_mutex_pairs(inherit[BENCH_LOCK_NESTING], inherit, BENCH_LOCK_NESTING, rounds));
+    MyRTOS_printf("  %-20s %5lu cycles/pair\n", "nested (ceiling)",
+                  bench_mutex_pairs(ceiling[BENCH_LOCK_NESTING], ceiling, BENCH_LOCK_NESTING, rounds));
+
+    start = bench_now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        Semaphore_Take(sem, MYRTOS_MAX_DELAY);
+        Semaphore_Give(sem);
+    }
+    cycles = bench_elapsed(start, bench_now());
+    MyRTOS_printf("  %-20s %5lu cycles/pair\n", "semaphore", cycles / rounds);
+
+    for (uint32_t i = 0; i <= BENCH_LOCK_NESTING; i++) {
+        Mutex_Delete(inherit[i]);
+        Mutex_Delete(ceiling[i]);
+    }
+    Semaphore_Delete(sem);
+    return 0;
+}
+
+// ============================================================================
+//                           bench event
+// ============================================================================
+
+static EventGroupHandle_t g_event_group;
+static volatile uint32_t g_event_woken;
+
+static void event_signal_waiter(void *param) {
+    (void) param;
+    for (;;) {
+        Task_WaitSignal(BENCH_EVENT_BIT, MYRTOS_MAX_DELAY, SIGNAL_WAIT_ANY | SIGNAL_CLEAR_ON_EXIT);
+        g_event_woken++;
+    }
+}
+
+static void event_group_waiter(void *param) {
+    (void) param;
+    for (;;) {
+        EventGroup_WaitBits(g_event_group, BENCH_EVENT_BIT, SIGNAL_WAIT_ANY | SIGNAL_CLEAR_ON_EXIT, MYRTOS_MAX_DELAY);
+        g_event_woken++;
+    }
+}
+
+static int bench_event_run(uint32_t waiter_count, uint32_t rounds) {
+    TaskHandle_t signal_tasks[BENCH_EVENT_MAX_WAITERS];
+    TaskHandle_t group_tasks[BENCH_EVENT_MAX_WAITERS];
+    uint32_t created = 0;
+
+    // 等待者优先级高于当前任务, 创建后立即运行并阻塞; 每次通知后也都在当前任务继续之前运行完毕
+    for (; created < waiter_count; created++) {
+        signal_tasks[created] = Task_Create(event_signal_waiter, "bench_sig", BENCH_TASK_STACK, NULL, BENCH_TASK_PRIO);
+        group_tasks[created] = Task_Create(event_group_waiter, "bench_evt", BENCH_TASK_STACK, NULL, BENCH_TASK_PRIO);
+        if (signal_tasks[created] == NULL || group_tasks[created] == NULL) {
+            // Task_Delete(NULL) 会删除当前任务, 只删除创建成功的那一个
+            if (signal_tasks[created] != NULL) {
+                Task_Delete(signal_tasks[created]);
+            }
+            if (group_tasks[created] != NULL) {
+                Task_Delete(group_tasks[created]);
+            }
+            break;
+        }
+    }
+
+    int result = -1;
+    if (created == waiter_count) {
+        g_event_woken = 0;
+        uint32_t start = bench_now();
+        for (uint32_t r = 0; r < rounds; r++) {
+            for (uint32_t i = 0; i < waiter_count; i++) {
+                Task_SendSignal(signal_tasks[i], BENCH_EVENT_BIT);
+            }
+        }
+        const uint32_t signal_cycles = bench_elapsed(start, bench_now());
+        const uint32_t signal_woken = g_event_woken;
+
+        g_event_woken = 0;
+        start = bench_now();
+        for (uint32_t r = 0; r < rounds; r++) {
+            EventGroup_SetBits(g_event_group, BENCH_EVENT_BIT);
+        }
+        const uint32_t group_cycles = bench_elapsed(start, bench_now());
+        const uint32_t group_woken = g_event_woken;
+
+        MyRTOS_printf("  %2lu waiters: signal x %-2lu %7lu  event group %7lu cycles/round  (woken %lu/%lu)\n",
+                      waiter_count, waiter_count, signal_cycles / rounds, group_cycles / rounds, signal_woken,
+                      group_woken);
+        result = 0;
+    } else {
+        MyRTOS_printf("  %2lu waiters: create failed (heap exhausted?)\n", waiter_count);
+    }
+    for (uint32_t i = 0; i < created; i++) {
+        Task_Delete(signal_tasks[i]);
+        Task_Delete(group_tasks[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief 测量唤醒 n 个等待同一事件的任务的开销
+ *        "signal" 对每个任务调用一次 Task_SendSignal, 每次唤醒都切换到等待者再切换回来;
+ *        "event group" 只调用一次 EventGroup_SetBits, 所有等待者在一次遍历中就绪, 只触发一次调度。
+ */
+static int bench_event(int argc, char *argv[]) {
+    static const uint32_t counts[] = {1, 4, 16, 32};
+    static StaticEventGroup_t group_buffer;
+    MyRTOS_printf("Wake n waiters, %d rounds, waiters at priority %d:\n", BENCH_EVENT_ROUNDS, BENCH_TASK_PRIO);
+    g_event_group = EventGroup_CreateStatic(&group_buffer);
+    int result = 0;
+    if (argc > 1) {
+        uint32_t n = (uint32_t) atoi(argv[1]);
+        if (n < 1 || n > BENCH_EVENT_MAX_WAITERS) {
+            MyRTOS_printf("Waiter count must be in [1, %d].\n", BENCH_EVENT_MAX_WAITERS);
+            result = -1;
+        } else {
+            result = bench_event_run(n, BENCH_EVENT_ROUNDS);
+        }
+    } else {
+        for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]) && result == 0; i++) {
+            result = bench_event_run(counts[i], BENCH_EVENT_ROUNDS);
+        }
+    }
+    EventGroup_Delete(g_event_group);
+    return result;
+}
+
+#if MYRTOS_USE_EDF == 1
+// ============================================================================
+//                           bench edf
+// ============================================================================
+
+typedef struct {
+    uint32_t wcet_ms; // 每个作业的执行时间
+    uint32_t deadline_ms; // 相对截止时间
+    uint32_t period_ms; // 周期
+    volatile uint32_t jobs; // 已完成的作业数
+} EdfTaskParam_t;
+
+static volatile uint8_t g_edf_stop;
+
+/**
+ * @brief 消耗指定的CPU时间
+ *        只累计两次读取之间的短间隔, 被抢占的时间不计入, 因此消耗的是任务自身的执行时间。
+ */
+static void edf_burn(uint32_t cycles) {
+    uint32_t consumed = 0;
+    uint32_t last = bench_now();
+    while (consumed < cycles) {
+        uint32_t now = bench_now();
+        uint32_t delta = bench_elapsed(last, now);
+        if (delta < BENCH_EDF_PREEMPT_GAP) {
+            consumed += delta;
+        }
+        last = now;
+    }
+}
+
+static void edf_worker(void *param) {
+    EdfTaskParam_t *p = (EdfTaskParam_t *) param;
+    const uint32_t cycles = p->wcet_ms * (MYRTOS_CPU_CLOCK_HZ / 1000);
+    while (!g_edf_stop) {
+        edf_burn(cycles);
+        p->jobs++;
+        Task_WaitForNextPeriod();
+    }
+    for (;;) {
+        Task_Wait();
+    }
+}
+
+/**
+ * @brief 以总利用率 0.9 的周期任务集运行 EDF 调度类, 统计截止时间错过次数
+ *        同样的任务集在单调速率 (RM) 固定优先级下不满足 Liu & Layland 界限 (0.78)。
+ */
+static int bench_edf(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+    static EdfTaskParam_t params[] = {
+        {2, 5, 5, 0},
+        {3, 10, 10, 0},
+        {4, 20, 20, 0},
+    };
+    TaskHandle_t tasks[sizeof(params) / sizeof(params[0])];
+    const size_t count = sizeof(params) / sizeof(params[0]);
+    size_t created = 0;
+
+    g_edf_stop = 0;
+    for (; created < count; created++) {
+        params[created].jobs = 0;
+        tasks[created] = Task_CreateEDF(edf_worker, "bench_edf", BENCH_TASK_STACK, &params[created],
+                                        MS_TO_TICKS(params[created].deadline_ms),
+                                        MS_TO_TICKS(params[created].period_ms));
+        if (tasks[created] == NULL) {
+            break;
+        }
+    }
+    if (created == count) {
+        Task_Delay(MS_TO_TICKS(BENCH_EDF_DURATION_MS));
+    }
+    g_edf_stop = 1;
+
+    MyRTOS_printf("EDF task set, U = 0.90, %d ms at priority %d:\n", BENCH_EDF_DURATION_MS, MYRTOS_EDF_PRIORITY);
+    for (size_t i = 0; i < created; i++) {
+        uint32_t misses = 0;
+#if MYRTOS_SERVICE_MONITOR_ENABLE == 1
+        TaskStats_t stats;
+        if (Monitor_GetTaskInfo(tasks[i], &stats) == 0) {
+            misses = stats.deadline_misses;
+        }
+#endif
+        MyRTOS_printf("  C=%lu D=%lu T=%lu ms: %5lu jobs, %lu deadline misses\n", params[i].wcet_ms,
+                      params[i].deadline_ms, params[i].period_ms, params[i].jobs, misses);
+        Task_Delete(tasks[i]);
+    }
+    if (created != count) {
+        MyRTOS_printf("  create failed (heap exhausted?)\n");
+        return -1;
+    }
+    return 0;
+}
+#endif /* MYRTOS_USE_EDF */
+
+// ============================================================================
+//                           bench irq
+// ============================================================================
+
+static volatile uint32_t g_irq_count;
+static volatile uint32_t g_irq_max_latency;
+static volatile uint64_t g_irq_total_latency;
+static volatile uint8_t g_irq_stop;
+static SemaphoreHandle_t g_irq_sems[2];
+
+/**
+ * @brief TIMER1 中断: 计数器从 RELOAD 递减到0时触发并自动重载,
+ *        进入中断时已经递减的计数值即为中断响应延迟。
+ * @note  该中断可能运行在零延迟层, 不调用任何内核API。
+ */
+void TIMER1_Handler(void) {
+    const uint32_t latency = CMSDK_TIMER1->RELOAD - CMSDK_TIMER1->VALUE;
+    CMSDK_TIMER1->INTSTATUS = 1;
+    g_irq_count++;
+    g_irq_total_latency += latency;
+    if (latency > g_irq_max_latency) {
+        g_irq_max_latency = latency;
+    }
+}
+
+/**
+ * @brief 负载任务: 两个任务通过一对信号量交替阻塞/唤醒, 每一轮之间再进入一段显式的内核临界区
+ * @note  信号量的获取与释放走内核的阻塞/唤醒路径, 显式临界区模拟唤醒大量等待者等较长的内核操作,
+ *        两者都在 BASEPRI (或 PRIMASK) 屏蔽下执行, 可调用内核API的中断会被推迟。
+ *        获取带1个滴答的超时, 另一个任务先退出时不会永久阻塞。
+ */
+static void irq_load_worker(void *param) {
+    const uint32_t self = (uint32_t) (uintptr_t) param;
+    while (!g_irq_stop) {
+        if (Semaphore_Take(g_irq_sems[self], 1) == 1) {
+            MyRTOS_Port_EnterCritical();
+            const uint32_t start = bench_now();
+            while (bench_elapsed(start, bench_now()) < BENCH_IRQ_CRITICAL_CYCLES) {
+            }
+            MyRTOS_Port_ExitCritical();
+            Semaphore_Give(g_irq_sems[self ^ 1]);
+        }
+    }
+    Task_Wait();
+}
+
+static int bench_irq_run(uint32_t nvic_priority, const char *label) {
+    TaskHandle_t workers[2] = {NULL, NULL};
+    g_irq_count = 0;
+    g_irq_max_latency = 0;
+    g_irq_total_latency = 0;
+    g_irq_stop = 0;
+
+    static StaticSemaphore_t sem_buffers[2];
+    // 信号量0初始可用, 由负载任务0开始往返
+    g_irq_sems[0] = Semaphore_CreateStatic(1, 1, &sem_buffers[0]);
+    g_irq_sems[1] = Semaphore_CreateStatic(1, 0, &sem_buffers[1]);
+    for (uint32_t i = 0; i < 2; i++) {
+        workers[i] = Task_Create(irq_load_worker, "bench_irq", BENCH_TASK_STACK, (void *) (uintptr_t) i,
+                                 BENCH_IRQ_LOAD_PRIO);
+        if (workers[i] == NULL) {
+            g_irq_stop = 1;
+            MyRTOS_printf("  create failed (heap exhausted?)\n");
+            if (workers[0] != NULL) {
+                Task_Delete(workers[0]);
+            }
+            Semaphore_Delete(g_irq_sems[0]);
+            Semaphore_Delete(g_irq_sems[1]);
+            return -1;
+        }
+    }
+
+    NVIC_SetPriority(TIMER1_IRQn, nvic_priority);
+    CMSDK_TIMER1->CTRL = 0;
+    CMSDK_TIMER1->RELOAD = BENCH_IRQ_PERIOD;
+    CMSDK_TIMER1->VALUE = BENCH_IRQ_PERIOD;
+    CMSDK_TIMER1->INTSTATUS = 1;
+    NVIC_ClearPendingIRQ(TIMER1_IRQn);
+    NVIC_EnableIRQ(TIMER1_IRQn);
+    CMSDK_TIMER1->CTRL = CMSDK_TIMER_CTRL_EN_Msk | CMSDK_TIMER_CTRL_IRQEN_Msk;
+
+    Task_Delay(MS_TO_TICKS(BENCH_IRQ_DURATION_MS));
+
+    CMSDK_TIMER1->CTRL = 0;
+    NVIC_DisableIRQ(TIMER1_IRQn);
+    g_irq_stop = 1;
+    Task_Delay(MS_TO_TICKS(10));
+    for (uint32_t i = 0; i < 2; i++) {
+        Task_Delete(workers[i]);
+    }
+    Semaphore_Delete(g_irq_sems[0]);
+    Semaphore_Delete(g_irq_sems[1]);
+
+    const uint32_t count = g_irq_count;
+    const uint32_t avg = count ? (uint32_t) (g_irq_total_latency / count) : 0;
+    MyRTOS_printf("  %-28s prio %lu: %6lu irqs, latency avg %4lu max %5lu cycles\n", label, nvic_priority, count,
+                  avg, g_irq_max_latency);
+    return 0;
+}
+
+/**
+ * @brief 在内核负载下测量 TIMER1 中断的响应延迟
+ *        负载为信号量往返加上每轮 BENCH_IRQ_CRITICAL_CYCLES 周期的显式临界区 (见 irq_load_worker)。
+ *        分别把 TIMER1 放在可调用内核API的优先级 (会被临界区推迟, 与 PRIMASK 临界区时所有中断的情况相同)
+ *        和高于 MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY 的零延迟层。
+ */
+static int bench_irq(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+    const uint32_t lowest = (1UL << __NVIC_PRIO_BITS) - 1;
+    MyRTOS_printf("IRQ latency under kernel load, period %d cycles, %d ms per run:\n", BENCH_IRQ_PERIOD,
+                  BENCH_IRQ_DURATION_MS);
+#if MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY > 0
+    if (bench_irq_run(lowest - 1, "kernel-aware (masked)") != 0) {
+        return -1;
+    }
+    return bench_irq_run(MYRTOS_MAX_SYSCALL_INTERRUPT_PRIORITY - 1, "zero-latency (BASEPRI)");
+#else
+    (void) lowest;
+    return bench_irq_run(0, "PRIMASK critical sections");
+#endif
+}
+
+// ============================================================================
+//                           程序入口
+// ============================================================================
+
+typedef struct {
+    const char *name;
+    int (*func)(int argc, char *argv[]);
+    const char *help;
+} BenchCommand_t;
+
+static const BenchCommand_t g_bench_commands[] = {
+    {"switch", bench_switch, "switch [n]   同优先级 n 个任务轮转的上下文切换开销 (默认 2~64)"},
+#if MYRTOS_SERVICE_COROUTINE_ENABLE == 1
+    {"co", bench_co, "co [n]       单个宿主任务中 n 个协程轮转的切换开销与内存占用 (默认 2/64/1024)"},
+#endif
+    {"tasks", bench_tasks, "tasks [n]    创建/运行/删除 n 个任务的单任务开销 (默认 64/256/1024)"},
+    {"spawn", bench_spawn, "spawn [n]    反复创建/删除一个任务 n 次的平均与最大开销 (默认 1000)"},
+    {"pt", bench_pt, "pt [n]       生产者/消费者传递 n 个产品, 比较有无抢占阈值时的切换次数 (默认 10000)"},
+    {"tick", bench_tick, "tick [n]     读取系统滴答计数的单次开销, 与关中断读取对照 (默认 10000)"},
+    {"lock", bench_lock, "lock [n]     无竞争时互斥锁 (继承/天花板)/信号量一次获取与释放的开销 (默认 10000)"},
+    {"event", bench_event, "event [n]    唤醒 n 个等待者: 逐个发送任务信号与事件组一次置位的开销 (默认 1/4/16/32)"},
+#if MYRTOS_USE_EDF == 1
+    {"edf", bench_edf, "edf          利用率 0.9 的周期任务集在 EDF 调度类下的截止时间错过次数"},
+#endif
+    {"irq", bench_irq, "irq          信号量往返与显式临界区负载下 TIMER1 中断的响应延迟 (临界区屏蔽层/零延迟层)"},
+};
+
+static int bench_main(int argc, char *argv[]) {
+    if (argc >= 2) {
+        for (size_t i = 0; i < sizeof(g_bench_commands) / sizeof(g_bench_commands[0]); i++) {
+            if (strcmp(argv[1], g_bench_commands[i].name) == 0) {
+                return g_bench_commands[i].func(argc - 1, &argv[1]);
+            }
+        }
+    }
+    MyRTOS_printf("Usage: bench <command> [args]\n");
+    for (size_t i = 0; i < sizeof(g_bench_commands) / sizeof(g_bench_commands[0]); i++) {
+        MyRTOS_printf("  %s\n", g_bench_commands[i].help);
+    }
+    return -1;
+}
+
+const ProgramDefinition_t g_program_bench = {
+    .name = "bench", .help = "内核性能测量. 用法: bench <switch|co|tasks|spawn|pt|tick|lock|event|edf|irq> [args]", .main_func = bench_main,
+};
+
+#endif /* MYRTOS_SERVICE_PROCESS_ENABLE */
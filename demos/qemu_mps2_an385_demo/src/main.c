@@ -100,6 +100,7 @@ const ProgramDefinition_t g_program_spawner = {
 extern const ProgramDefinition_t g_program_init;
 extern const ProgramDefinition_t g_program_shell;
 extern const ProgramDefinition_t g_program_log;
+extern const ProgramDefinition_t g_program_bench;
 
 // ============================================================================
 //                           任务函数声明
@@ -172,6 +173,7 @@ static void on_services_init(void) {
     Process_RegisterProgram(&g_program_hello);
     Process_RegisterProgram(&g_program_spawner);
     Process_RegisterProgram(&g_program_log);
+    Process_RegisterProgram(&g_program_bench);
 #endif
 }
 
@@ -509,10 +511,15 @@ static int blinky_main(int argc, char *argv[]) {
     (void)argv;
 
     int count = 0;
+    // 按绝对的释放点计算等待时间, 心跳周期不随打印耗时漂移
+    uint64_t next_wake = MyRTOS_GetTick();
     while (1) {
         MyRTOS_printf("[blinky] Heartbeat %d\n", count++);
 
-        uint32_t signals = Task_WaitSignal(SIG_INTERRUPT, MS_TO_TICKS(1000),
+        next_wake += MS_TO_TICKS(1000);
+        uint64_t now = MyRTOS_GetTick();
+        uint32_t timeout = (next_wake > now) ? (uint32_t)(next_wake - now) : 0;
+        uint32_t signals = Task_WaitSignal(SIG_INTERRUPT, timeout,
                                           SIGNAL_WAIT_ANY | SIGNAL_CLEAR_ON_EXIT);
 
         if (signals & SIG_INTERRUPT) {
@@ -529,10 +536,11 @@ static int looper_main(int argc, char *argv[]) {
     (void) argv;
     int count = 0;
     const char *task_name = Task_GetName(NULL);
+    uint64_t last_wake = MyRTOS_GetTick();
     for (;;) {
         MyRTOS_printf("[looper BG via printf] This message should be SILENT in background. Count: %d\n", count);
         LOG_I(task_name, "Hello from background via LOG! Count: %d", ++count);
-        Task_Delay(MS_TO_TICKS(2000));
+        Task_DelayUntil(&last_wake, MS_TO_TICKS(2000));
     }
     return 0;
 }